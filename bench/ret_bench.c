@@ -0,0 +1,375 @@
+/**************************************************************************//**
+ * @file ret_bench.c
+ * @brief RET framework overhead benchmark (host)
+ *
+ * Generates synthetic test trees and measures what the RET engine itself
+ * costs per node (list walk, tag construction & search, setjmp and report
+ * formatting) with empty leaf functions.  Each tree is run in EXE, SKIP and
+ * SEARCH mode:
+ *   EXE    - root selected, every node executed and reported
+ *   SKIP   - last leaf selected, every other node walked without executing
+ *   SEARCH - root searched, every node listed
+ * and the branch and missing selections show the cost of partial runs.
+ *
+ * Results are printed one line per run: leaves, depth, tag length, mode,
+ * selection, nodes, ns per node, report bytes per node and the process peak
+ * resident memory (including the generated tree).
+ *
+ * Build & run on host (no target headers required):
+ * @code
+ * cc -O2 -DRET_TEST -DRET_HOST -I.. ../ret.c ret_bench.c -o ret_bench
+ * ./ret_bench                               # standard sweep
+ * ./ret_bench -l 1000000 -d 5 -t 16 -r 3    # 1M leaves, depth 5, 16 char tags
+ * @endcode
+ * The tree depth is limited by RET_MAX_NEST_SIZE (the root and trunk use the
+ * first nest level) and the tag path by RET_MAX_TAG_STRING_SIZE; both may be
+ * overridden on the compiler command line to size trees for a target.
+ */
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <sys/resource.h>
+#include "ret.h"
+
+
+/******************************************************************************
+* S T A T I C    D A T A T Y P E S
+******************************************************************************/
+/**
+ * @brief Synthetic tree level (all lists of one depth)
+ */
+typedef struct {
+  ret_list_t* lists; /**< One list per branch node of the previous level */
+  uint32_t    next; /**< Next list to run (walk order of the branch nodes) */
+} bench_level_t;
+
+/**
+ * @brief Benchmark run configuration
+ */
+typedef struct {
+  uint32_t    leaves; /**< Requested leaf count (rounded to fanout^depth) */
+  uint32_t    depth; /**< Levels below the trunk */
+  uint32_t    tag_len; /**< Length of each generated tag */
+  uint32_t    repeat; /**< Runs per measurement (best run is reported) */
+} bench_cfg_t;
+
+
+/******************************************************************************
+* S T A T I C   D A T A
+******************************************************************************/
+static bench_level_t  bench_level[RET_MAX_NEST_SIZE];
+static uint32_t       bench_depth;
+static ret_test_t*    bench_nodes;
+static char*          bench_tags;
+static uint32_t       bench_node_count;
+static uint64_t       bench_tx_bytes;
+
+
+/******************************************************************************
+* S T A T I C    F U N C T I O N    P R O T O T Y P E S
+******************************************************************************/
+static ret_retval_t benchBranch   (ret_param_t* param);
+static ret_retval_t benchLeaf     (ret_param_t* param);
+static bool       benchBuild      (bench_cfg_t* cfg, uint32_t* fanout);
+static void       benchFree       (void);
+static void       benchRun        (bench_cfg_t* cfg, uint32_t fanout,
+                                   ret_mode_t mode, const char* mode_name,
+                                   const char* test_tag, const char* sel_name);
+static uint64_t   benchNanoseconds(void);
+
+
+/**************************************************************************//**
+ * @brief Host timer for RET_SYS_TICK_FUNC()
+ * @param none
+ * @return uint32_t - milliseconds
+ */
+uint32_t retHostTick(void) {
+  return (uint32_t)(benchNanoseconds() / 1000000u);
+}
+
+
+/**************************************************************************//**
+ * @brief Host report transmit for RET_SEND_BUF() - count & discard
+ * @param char* - report buffer
+ * @return none
+ */
+void retHostSend(const char* str) {
+  bench_tx_bytes += strlen(str);
+}
+
+
+/**************************************************************************//**
+ * @brief RET trunk - runs the first level of the synthetic tree
+ * @param ret_param_t* - pointer to user control structure
+ * @return ret_retval_t
+ */
+ret_retval_t RunTrunk(ret_param_t* param) {
+  return benchBranch(param);
+}
+
+
+/**************************************************************************//**
+ * @brief Synthetic branch
+ *
+ * Branch nodes of a level are walked in the same order in every mode, so the
+ * n-th call at a depth runs the n-th list of the next level.
+ *
+ * @param ret_param_t* - pointer to user control structure
+ * @return ret_retval_t
+ */
+static ret_retval_t benchBranch(ret_param_t* param) {
+  bench_level_t* level = &bench_level[bench_depth++];
+  ret_retval_t retval;
+
+  retval = retExecuteList(param, &level->lists[level->next++]);
+  bench_depth--;
+  return retval;
+}
+
+
+/**************************************************************************//**
+ * @brief Synthetic (empty) leaf
+ * @param ret_param_t* - pointer to user control structure
+ * @return ret_retval_t
+ */
+static ret_retval_t benchLeaf(ret_param_t* param) {
+  RET_MODE_SEARCH();
+
+  return RET_PASS;
+}
+
+
+/**************************************************************************//**
+ * @brief Generate a tree of fanout^depth leaves with unique padded tags
+ * @param bench_cfg_t* - run configuration
+ * @param uint32_t* - fanout of every branch node
+ * @return bool - false if the tree does not fit the RET limits or memory
+ */
+static bool benchBuild(bench_cfg_t* cfg, uint32_t* fanout) {
+  uint32_t lists, width, d, i, n;
+  uint64_t leaves;
+  char*    tag;
+
+  /* ROOT occupies the first nest level */
+  if((cfg->depth == 0) || (cfg->depth > RET_MAX_NEST_SIZE - 1)) {
+    fprintf(stderr, "depth must be 1..%d\n", RET_MAX_NEST_SIZE - 1);
+    return false;
+  }
+  if((cfg->depth * (cfg->tag_len + 1) + sizeof RET_ROOT_TAG) >=
+     RET_MAX_TAG_STRING_SIZE) {
+    fprintf(stderr, "tag path exceeds RET_MAX_TAG_STRING_SIZE\n");
+    return false;
+  }
+
+  /* Smallest fanout whose leaf count reaches the requested count */
+  for(*fanout = 2; ; (*fanout)++) {
+    for(d = 0, leaves = 1; d < cfg->depth; d++)
+      leaves *= *fanout;
+    if(leaves >= cfg->leaves)
+      break;
+  }
+
+  /* Count nodes & check tag width (tags are 'n' + node number + padding) */
+  for(d = 0, lists = 1, bench_node_count = 0; d < cfg->depth; d++) {
+    bench_node_count += lists * *fanout;
+    lists *= *fanout;
+  }
+  for(n = bench_node_count, width = 1; n >= 10; n /= 10)
+    width++;
+  if(cfg->tag_len < width + 1) {
+    fprintf(stderr, "tag length must be at least %u\n", width + 1);
+    return false;
+  }
+
+  bench_nodes = malloc(bench_node_count * sizeof *bench_nodes);
+  bench_tags = malloc((size_t)bench_node_count * (cfg->tag_len + 1));
+  if((bench_nodes == NULL) || (bench_tags == NULL))
+    return false;
+
+  for(d = 0, lists = 1, n = 0; d < cfg->depth; d++) {
+    bench_level[d].lists = malloc(lists * sizeof *bench_level[d].lists);
+    if(bench_level[d].lists == NULL)
+      return false;
+    for(i = 0; i < lists; i++) {
+      bench_level[d].lists[i].size = *fanout;
+      bench_level[d].lists[i].first = &bench_nodes[n + i * *fanout];
+    }
+    for(i = 0; i < lists * *fanout; i++, n++) {
+      tag = bench_tags + (size_t)n * (cfg->tag_len + 1);
+      memset(tag, 'x', cfg->tag_len);
+      tag[cfg->tag_len] = '\0';
+      tag[0] = 'n';
+      retConvIntToDecAscii(tag + 1, (int32_t)n);
+      if(1 + strlen(tag + 1) < cfg->tag_len)
+        tag[1 + strlen(tag + 1)] = 'x';
+      bench_nodes[n].func = (d + 1 < cfg->depth) ? benchBranch : benchLeaf;
+      bench_nodes[n].tag = tag;
+      bench_nodes[n].cases = NULL;
+      bench_nodes[n].tag_len = 0;
+      bench_nodes[n].deps = NULL;
+    }
+    lists *= *fanout;
+  }
+  return true;
+}
+
+
+/**************************************************************************//**
+ * @brief Release the generated tree
+ * @param none
+ * @return none
+ */
+static void benchFree(void) {
+  uint32_t d;
+
+  for(d = 0; d < RET_MAX_NEST_SIZE; d++) {
+    free(bench_level[d].lists);
+    bench_level[d].lists = NULL;
+  }
+  free(bench_nodes);
+  free(bench_tags);
+  bench_nodes = NULL;
+  bench_tags = NULL;
+}
+
+
+/**************************************************************************//**
+ * @brief Run the tree in one mode & selection and print the best run
+ * @param bench_cfg_t* - run configuration
+ * @param uint32_t - fanout of every branch node
+ * @param ret_mode_t - RET_MODE_EXE or RET_MODE_SEARCH
+ * @param char* - mode name for the result line
+ * @param char* - test tag selection
+ * @param char* - selection name for the result line
+ * @return none
+ */
+static void benchRun(bench_cfg_t* cfg, uint32_t fanout, ret_mode_t mode,
+                     const char* mode_name, const char* test_tag,
+                     const char* sel_name) {
+  ret_param_t   param;
+  struct rusage usage;
+  uint64_t      start, elapsed, best = UINT64_MAX;
+  uint32_t      r, d;
+
+  for(r = 0; r < cfg->repeat; r++) {
+    retParamInit(&param, mode, (char*)test_tag);
+    for(d = 0; d < RET_MAX_NEST_SIZE; d++)
+      bench_level[d].next = 0;
+    bench_depth = 0;
+    bench_tx_bytes = 0;
+
+    start = benchNanoseconds();
+    retStart(&param);
+    elapsed = benchNanoseconds() - start;
+    if(elapsed < best)
+      best = elapsed;
+  }
+
+  getrusage(RUSAGE_SELF, &usage);
+  printf("%8u %5u %4u %2u %-6s %-7s %8u %9.1f %7.1f %8ld\n",
+         (unsigned)cfg->leaves, (unsigned)fanout, (unsigned)cfg->depth,
+         (unsigned)cfg->tag_len, mode_name, sel_name,
+         (unsigned)bench_node_count, (double)best / bench_node_count,
+         (double)bench_tx_bytes / bench_node_count, usage.ru_maxrss);
+  fflush(stdout);
+}
+
+
+/**************************************************************************//**
+ * @brief Monotonic host time
+ * @param none
+ * @return uint64_t - nanoseconds
+ */
+static uint64_t benchNanoseconds(void) {
+  struct timespec ts;
+
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+}
+
+
+/**************************************************************************//**
+ * @brief Benchmark one tree configuration in every mode
+ * @param bench_cfg_t* - run configuration
+ * @return int - 0 on success
+ */
+static int benchTree(bench_cfg_t* cfg) {
+  uint32_t fanout;
+  char     last_leaf[RET_MAX_TAG_STRING_SIZE];
+  char     last_branch[RET_MAX_TAG_STRING_SIZE];
+
+  if(!benchBuild(cfg, &fanout)) {
+    benchFree();
+    return 1;
+  }
+
+  strcpy(last_leaf, bench_nodes[bench_node_count - 1].tag);
+  strcpy(last_branch, bench_nodes[fanout - 1].tag);
+
+  benchRun(cfg, fanout, RET_MODE_EXE, "EXE", RET_ROOT_TAG, "root");
+  benchRun(cfg, fanout, RET_MODE_EXE, "EXE", last_branch, "branch");
+  benchRun(cfg, fanout, RET_MODE_EXE, "SKIP", last_leaf, "leaf");
+  benchRun(cfg, fanout, RET_MODE_EXE, "SKIP", "no_such_tag", "none");
+  benchRun(cfg, fanout, RET_MODE_SEARCH, "SEARCH", RET_ROOT_TAG, "root");
+
+  benchFree();
+  return 0;
+}
+
+
+/**************************************************************************//**
+ * @brief Benchmark entry point
+ *
+ * Options: -l leaves, -d depth, -t tag length, -r repeat count.  Without a
+ * leaf count a standard sweep of tree sizes, depths and tag lengths is run.
+ *
+ * @param int - argument count
+ * @param char** - arguments
+ * @return int - 0 on success
+ */
+int main(int argc, char** argv) {
+  static const uint32_t sweep_leaves[] = {10000, 100000, 1000000};
+  static const uint32_t sweep_tag_len[] = {8, 24};
+  static const uint32_t sweep_depth[] = {2, 3, RET_MAX_NEST_SIZE - 1};
+  bench_cfg_t cfg = {0, 0, 8, 3};
+  uint32_t    l, t, d;
+  int         i, err = 0;
+
+  for(i = 1; i + 1 < argc; i += 2) {
+    if(strcmp(argv[i], "-l") == 0)
+      cfg.leaves = (uint32_t)strtoul(argv[i + 1], NULL, 0);
+    else if(strcmp(argv[i], "-d") == 0)
+      cfg.depth = (uint32_t)strtoul(argv[i + 1], NULL, 0);
+    else if(strcmp(argv[i], "-t") == 0)
+      cfg.tag_len = (uint32_t)strtoul(argv[i + 1], NULL, 0);
+    else if(strcmp(argv[i], "-r") == 0)
+      cfg.repeat = (uint32_t)strtoul(argv[i + 1], NULL, 0);
+  }
+  if(cfg.repeat == 0)
+    cfg.repeat = 1;
+
+  printf("%8s %5s %4s %2s %-6s %-7s %8s %9s %7s %8s\n", "leaves", "fan",
+         "dpth", "tl", "mode", "select", "nodes", "ns/node", "B/node",
+         "peak_kB");
+
+  if(cfg.leaves != 0) {
+    if(cfg.depth == 0)
+      cfg.depth = RET_MAX_NEST_SIZE - 1;
+    return benchTree(&cfg);
+  }
+
+  for(l = 0; l < sizeof sweep_leaves / sizeof *sweep_leaves; l++) {
+    for(t = 0; t < sizeof sweep_tag_len / sizeof *sweep_tag_len; t++) {
+      for(d = 0; d < sizeof sweep_depth / sizeof *sweep_depth; d++) {
+        cfg.leaves = sweep_leaves[l];
+        cfg.tag_len = sweep_tag_len[t];
+        cfg.depth = sweep_depth[d];
+        err |= benchTree(&cfg);
+      }
+    }
+  }
+  return err;
+}
@@ -31,18 +31,18 @@ static ret_list_t trunk_list = {
  * @return none
  */
 void Test(void) {
-  /* Global user configuration that is passed to all test functions */
+  /* Global user configuration that is passed to all test functions
+   * (retParamInit zeroes the user elements that are not set) */
   ret_param_t param;
 
 #if 1
   /* Run tests */
-  param.mode = RET_MODE_EXE;
-  param.test_tag = RET_ROOT_TAG; // Executes entire compiled test tree
+  retParamInit(&param, RET_MODE_EXE, RET_ROOT_TAG); // Entire test tree
   //param.test_tag = "Group1Test1"; // Execute Group1Test1 only
+  //param.report = RET_REPORT_SUMMARY; // Failures & branch rollups only
 #else
   /* Search test tree  */
-  param.mode = RET_MODE_SEARCH;
-  param.test_tag = RET_ROOT_TAG; // Display tags for all compiled tests
+  retParamInit(&param, RET_MODE_SEARCH, RET_ROOT_TAG); // All compiled tests
   //param.test_tag = "group_1_tests"; // Display test tags for group_1_tests
 #endif
 
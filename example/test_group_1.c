@@ -4,11 +4,17 @@
 
 static ret_retval_t Group1Test0(ret_param_t* param);
 static ret_retval_t Group1Test1(ret_param_t* param);
+static ret_retval_t Group1AsyncTest0(ret_param_t* param);
+static ret_retval_t Group1AsyncTest1(ret_param_t* param);
+static ret_retval_t Group1SleepTest(ret_param_t* param);
 
 /* Example of a test list that contains both leaf and branch functions */
 static ret_test_t tests [] = {
   {Group1Test0, "Group1Test0"},
   {Group1Test1, "Group1Test1"},
+  {Group1AsyncTest0, "Group1AsyncTest0"},
+  {Group1AsyncTest1, "Group1AsyncTest1"},
+  {Group1SleepTest, "Group1SleepTest"},
 #ifdef RET_GROUP_2_TESTS
   {group_2_tests, "group_2_tests"}
 #endif
@@ -37,4 +43,59 @@ static ret_retval_t Group1Test1(ret_param_t* param) {
   return RET_PASS;
 }
 
+/* Simulated converter for the async examples - a conversion started with
+ * sampleStart() is ready after 'ticks' and reads back the sampled value */
+typedef struct {
+  uint32_t ready_at;
+  int32_t  value;
+} sample_t;
+
+static sample_t sample[2];
+
+static void sampleStart(sample_t* s, int32_t value, uint32_t ticks) {
+  s->ready_at = RET_CLOCK_NOW() + ticks;
+  s->value = value;
+}
+static bool sampleReady(const sample_t* s) {
+  return (int32_t)(RET_CLOCK_NOW() - s->ready_at) >= 0;
+}
+static int32_t sampleRead(const sample_t* s) {
+  return sampleReady(s) ? s->value : -1;
+}
+
+/* Example of async leaves - both waits overlap rather than run back to back */
+static ret_retval_t Group1AsyncTest0(ret_param_t* param) {
+  RET_MODE_SEARCH();
+
+  RET_ASYNC_BEGIN(100);
+  sampleStart(&sample[0], 1234, 20);
+  RET_AWAIT(sampleReady(&sample[0]));
+  RET_ASSERT(sampleRead(&sample[0]) == 1234);
+  RET_ASYNC_END();
+}
+static ret_retval_t Group1AsyncTest1(ret_param_t* param) {
+  RET_MODE_SEARCH();
+
+  RET_ASYNC_BEGIN(100);
+  sampleStart(&sample[1], -42, 30);
+  param->async->user = (uintptr_t)&sample[1];
+  RET_AWAIT(sampleReady((const sample_t*)param->async->user));
+  RET_YIELD();
+  RET_ASSERT(sampleRead((const sample_t*)param->async->user) == -42);
+  RET_ASYNC_END();
+}
+
+/* Example of a timed wait - takes no real time with RET_VIRTUAL_CLOCK */
+static ret_retval_t Group1SleepTest(ret_param_t* param) {
+  uint32_t start;
+
+  RET_MODE_SEARCH();
+
+  start = RET_CLOCK_NOW();
+  RET_CLOCK_SLEEP(50);
+  RET_ASSERT(RET_CLOCK_NOW() - start >= 50);
+
+  return RET_PASS;
+}
+
 #endif // #ifdef RET_GROUP_1_TESTS
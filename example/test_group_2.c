@@ -4,10 +4,32 @@
 
 static ret_retval_t Group2Test0(ret_param_t* param);
 static ret_retval_t Group2Test1(ret_param_t* param);
+static ret_retval_t Group2AddTest(ret_param_t* param);
+
+/* Example of a parameterized test - Group2AddTest runs once per vector and
+ * reports each as Group2AddTest[n] */
+typedef struct {
+  int32_t a;
+  int32_t b;
+  int32_t sum;
+} add_vector_t;
+
+static const add_vector_t add_vectors[] = {
+  {0, 0, 0},
+  {1, 2, 3},
+  {-5, 5, 0},
+  {1000, -1, 999}
+};
+static const ret_cases_t add_cases = RET_CASES(add_vectors);
+
+/* Example of a prerequisite - Group2Test1 is reported BLOCKED without being
+ * executed if Group2Test0 fails */
+static const char* const test1_deps[] = {"Group2Test0", NULL};
 
 static ret_test_t tests [] = {
   {Group2Test0, "Group2Test0"},
-  {Group2Test1, "Group2Test1"}
+  {Group2Test1, "Group2Test1", NULL, 0, test1_deps},
+  {Group2AddTest, "Group2AddTest", &add_cases}
 };
 static ret_list_t test_list = {
   sizeof tests / sizeof *tests,
@@ -28,10 +50,22 @@ static ret_retval_t Group2Test0(ret_param_t* param) {
 static ret_retval_t Group2Test1(ret_param_t* param) {
   RET_MODE_SEARCH();
 
+  /* User span shown in the execution trace when RET_TRACE is defined */
+  RET_TRACE_BEGIN("Group2Test1 setup");
+  RET_TRACE_END("Group2Test1 setup");
   RET_ASSERT(1);
 
   return RET_PASS;
 }
+static ret_retval_t Group2AddTest(ret_param_t* param) {
+  const add_vector_t* vector = RET_CASE(add_vector_t);
+
+  RET_MODE_SEARCH();
+
+  RET_ASSERT(vector->a + vector->b == vector->sum);
+
+  return RET_PASS;
+}
 
 
 #endif // #ifdef RET_GROUP_2_TESTS
@@ -0,0 +1,49 @@
+/**************************************************************************//**
+ * @file ret_cache.h
+ * @brief RET cache flush ports
+ *
+ * Pass one of these ports to retSetCachePort() before a RET_CACHE_COLD run
+ * to flush the caches before each executed test (see ret_cache_t):
+ * @code
+ * retSetCachePort(&ret_cache_host);
+ * param.cache = RET_CACHE_COLD;
+ * retStart(&param);
+ * @endcode
+ * Compile ret_cache_host.c into a host build (RET_HOST) and
+ * ret_cache_cortexm.c into a Cortex-M7 or Cortex-M33 target build.
+ */
+#ifndef __RET_CACHE_H_
+#define __RET_CACHE_H_
+
+#include "ret.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/******************************************************************************
+* P U B L I C    D A T A
+******************************************************************************/
+/**
+ * @brief Host cache sweep port
+ *
+ * Reads a buffer of twice the size of the largest data cache, which evicts
+ * the data of the previous test from every cache level.  Instruction caches
+ * and branch predictors are not flushed.
+ */
+extern const ret_cache_port_t ret_cache_host;
+
+/**
+ * @brief Cortex-M cache port
+ *
+ * Cortex-M7: cleans & invalidates the D-cache and invalidates the I-cache
+ * and the branch predictor.  Cortex-M33 (STM32): invalidates the ICACHE
+ * flash cache.  The flush is unavailable if no cache is enabled.
+ */
+extern const ret_cache_port_t ret_cache_cortexm;
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  /* __RET_CACHE_H_ */
@@ -0,0 +1,76 @@
+/**************************************************************************//**
+ * @file ret_cache_cortexm.c
+ * @brief RET cache flush port for Cortex-M7 and Cortex-M33 targets
+ *
+ * Cortex-M7 caches are maintained with the CMSIS cache functions and the
+ * branch predictor is invalidated with BPIALL.  Cortex-M33 has no core
+ * caches; STM32 devices cache flash with the ICACHE peripheral, which is
+ * invalidated.  The STM32 DCACHE (external memories only) is not flushed.
+ * Requires the CMSIS core header of the target (via the device HAL header).
+ */
+#if defined(RET_TEST) && !defined(RET_HOST)
+
+#include "ret_cache.h"
+#include "stm32h5xx_hal.h"
+
+
+/******************************************************************************
+* S T A T I C    F U N C T I O N    P R O T O T Y P E S
+******************************************************************************/
+static bool     cmOpen    (void);
+static void     cmFlush   (void);
+
+
+/******************************************************************************
+* P U B L I C    D A T A
+******************************************************************************/
+const ret_cache_port_t ret_cache_cortexm = {
+  cmOpen, cmFlush
+};
+
+
+/**************************************************************************//**
+ * @brief Check that a cache is enabled
+ * @param none
+ * @return bool - false if there is no enabled cache to flush
+ */
+static bool cmOpen(void) {
+#if (__CORTEX_M == 7U)
+  return (SCB->CCR & (SCB_CCR_IC_Msk | SCB_CCR_DC_Msk)) != 0U;
+#elif defined(ICACHE)
+  return (ICACHE->CR & ICACHE_CR_EN) != 0U;
+#else
+  return false;
+#endif
+}
+
+
+/**************************************************************************//**
+ * @brief Clean & invalidate the caches
+ * @param none
+ * @return none
+ */
+static void cmFlush(void) {
+#if (__CORTEX_M == 7U)
+#if defined(__DCACHE_PRESENT) && (__DCACHE_PRESENT == 1U)
+  if(SCB->CCR & SCB_CCR_DC_Msk)
+    SCB_CleanInvalidateDCache();
+#endif
+#if defined(__ICACHE_PRESENT) && (__ICACHE_PRESENT == 1U)
+  if(SCB->CCR & SCB_CCR_IC_Msk)
+    SCB_InvalidateICache();
+#endif
+  SCB->BPIALL = 0U;
+  __DSB();
+  __ISB();
+#elif defined(ICACHE)
+  /* Invalidation ends with BSYENDF set */
+  ICACHE->FCR = ICACHE_FCR_CBSYENDF;
+  ICACHE->CR |= ICACHE_CR_CACHEINV;
+  while((ICACHE->SR & ICACHE_SR_BSYENDF) == 0U)
+    ;
+  ICACHE->FCR = ICACHE_FCR_CBSYENDF;
+#endif
+}
+
+#endif /* #if defined(RET_TEST) && !defined(RET_HOST) */
@@ -0,0 +1,122 @@
+/**************************************************************************//**
+ * @file ret_cache_host.c
+ * @brief RET cache flush port for hosts (buffer sweep)
+ *
+ * A host program cannot invalidate the CPU caches, so the flush reads a
+ * buffer that is larger than the last level cache, which replaces every line
+ * the previous test left in the data caches.  The cache sizes are read with
+ * sysconf where the C library reports them (glibc).
+ */
+#if defined(RET_TEST) && defined(RET_HOST)
+
+#define _GNU_SOURCE
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include "ret_cache.h"
+
+
+/******************************************************************************
+* S T A T I C    D E F I N I T I O N S
+******************************************************************************/
+#define SWEEP_DEFAULT_SIZE  (32u << 20) /* Cache size unknown */
+#define SWEEP_MIN_SIZE      (4u << 20)
+#define SWEEP_LINE_SIZE     64 /* Cache line size unknown */
+
+
+/******************************************************************************
+* S T A T I C    D A T A
+******************************************************************************/
+static uint8_t* sweep_buf;
+static size_t   sweep_size;
+static size_t   sweep_line;
+
+/* Sum of the swept lines (keeps the reads) */
+static volatile uint8_t sweep_sink;
+
+
+/******************************************************************************
+* S T A T I C    F U N C T I O N    P R O T O T Y P E S
+******************************************************************************/
+static bool     sweepOpen   (void);
+static void     sweepFlush  (void);
+#ifdef _SC_LEVEL3_CACHE_SIZE
+static size_t   sweepConf   (int name);
+#endif
+
+
+/******************************************************************************
+* P U B L I C    D A T A
+******************************************************************************/
+const ret_cache_port_t ret_cache_host = {
+  sweepOpen, sweepFlush
+};
+
+
+/**************************************************************************//**
+ * @brief Allocate the sweep buffer (first run only)
+ * @param none
+ * @return bool - false if the buffer cannot be allocated
+ */
+static bool sweepOpen(void) {
+  size_t size = 0;
+#ifdef _SC_LEVEL3_CACHE_SIZE
+  size_t level;
+#endif
+
+  if(sweep_buf != NULL)
+    return true;
+
+#ifdef _SC_LEVEL3_CACHE_SIZE
+  size = sweepConf(_SC_LEVEL3_CACHE_SIZE);
+  level = sweepConf(_SC_LEVEL2_CACHE_SIZE);
+  if(level > size)
+    size = level;
+  sweep_line = sweepConf(_SC_LEVEL1_DCACHE_LINESIZE);
+#endif
+  size = (size == 0) ? SWEEP_DEFAULT_SIZE : 2 * size;
+  if(size < SWEEP_MIN_SIZE)
+    size = SWEEP_MIN_SIZE;
+  if(sweep_line == 0)
+    sweep_line = SWEEP_LINE_SIZE;
+
+  sweep_buf = (uint8_t*)malloc(size);
+  if(sweep_buf == NULL)
+    return false;
+  /* Map every page now so that the sweep does not fault */
+  memset(sweep_buf, 1, size);
+  sweep_size = size;
+  return true;
+}
+
+
+/**************************************************************************//**
+ * @brief Read one byte of every cache line of the sweep buffer
+ * @param none
+ * @return none
+ */
+static void sweepFlush(void) {
+  const uint8_t* pos;
+  uint8_t sum = 0;
+
+  for(pos = sweep_buf; pos < sweep_buf + sweep_size; pos += sweep_line)
+    sum += *pos;
+  sweep_sink = sum;
+}
+
+
+#ifdef _SC_LEVEL3_CACHE_SIZE
+/**************************************************************************//**
+ * @brief Read a cache size from sysconf
+ * @param int - sysconf name
+ * @return size_t - value or 0 if not reported
+ */
+static size_t sweepConf(int name) {
+  long value = sysconf(name);
+
+  return (value > 0) ? (size_t)value : 0;
+}
+#endif
+
+#endif /* #if defined(RET_TEST) && defined(RET_HOST) */
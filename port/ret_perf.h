@@ -0,0 +1,47 @@
+/**************************************************************************//**
+ * @file ret_perf.h
+ * @brief RET performance counter ports
+ *
+ * Pass one of these ports to retSetPerfPort() before retStart() to add the
+ * counts of each reported leaf to the test report (see ret_perf_port_t):
+ * @code
+ * retSetPerfPort(&ret_perf_linux);
+ * retStart(&param);
+ * @endcode
+ * Compile ret_perf_linux.c into a host build (RET_HOST) and ret_perf_dwt.c
+ * into a Cortex-M target build.
+ */
+#ifndef __RET_PERF_H_
+#define __RET_PERF_H_
+
+#include "ret.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/******************************************************************************
+* P U B L I C    D A T A
+******************************************************************************/
+/**
+ * @brief Linux perf_event_open port
+ *
+ * User space cycles, instructions, cache-misses and branch-misses of the
+ * calling thread.  Events the kernel or CPU cannot count are left out.
+ */
+extern const ret_perf_port_t ret_perf_linux;
+
+/**
+ * @brief Cortex-M DWT port
+ *
+ * cycles (CYCCNT) plus the 8 bit DWT profiling counters cpi, exc, sleep,
+ * lsu and fold where the core implements them.  The 8 bit counters wrap, so
+ * they are meaningful for short leaves only (ie: algorithm kernels).
+ */
+extern const ret_perf_port_t ret_perf_dwt;
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  /* __RET_PERF_H_ */
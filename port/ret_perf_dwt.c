@@ -0,0 +1,104 @@
+/**************************************************************************//**
+ * @file ret_perf_dwt.c
+ * @brief RET performance counter port for Cortex-M DWT counters
+ *
+ * CYCCNT counts core cycles.  The 8 bit profiling counters count the extra
+ * cycles of multi-cycle instructions (CPI), exception overhead (EXC), sleep
+ * (SLEEP), load/store (LSU) and the folded instructions (FOLD).  Armv8-M
+ * cores report missing counters through DWT_CTRL.NOCYCCNT and NOPRFCNT.
+ * Requires the CMSIS core header of the target (via the device HAL header).
+ */
+#if defined(RET_TEST) && !defined(RET_HOST)
+
+#include "ret_perf.h"
+#include "stm32h5xx_hal.h"
+
+
+/******************************************************************************
+* S T A T I C    D A T A
+******************************************************************************/
+static const char* const dwt_names[] = {
+  "cycles", "cpi", "exc", "sleep", "lsu", "fold"
+};
+
+#define DWT_PRF_ENA_MSK (DWT_CTRL_CPIEVTENA_Msk | DWT_CTRL_EXCEVTENA_Msk | \
+                         DWT_CTRL_SLEEPEVTENA_Msk | DWT_CTRL_LSUEVTENA_Msk | \
+                         DWT_CTRL_FOLDEVTENA_Msk)
+
+static uint32_t dwt_count;
+
+
+/******************************************************************************
+* S T A T I C    F U N C T I O N    P R O T O T Y P E S
+******************************************************************************/
+static uint32_t dwtOpen   (void);
+static void     dwtStart  (void);
+static void     dwtStop   (uint32_t* counts);
+
+
+/******************************************************************************
+* P U B L I C    D A T A
+******************************************************************************/
+const ret_perf_port_t ret_perf_dwt = {
+  dwtOpen, dwtStart, dwtStop, dwt_names
+};
+
+
+/**************************************************************************//**
+ * @brief Enable the DWT counters
+ * @param none
+ * @return uint32_t - number of counters available
+ */
+static uint32_t dwtOpen(void) {
+  CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+
+  if(DWT->CTRL & DWT_CTRL_NOCYCCNT_Msk)
+    dwt_count = 0;
+  else if(DWT->CTRL & DWT_CTRL_NOPRFCNT_Msk)
+    dwt_count = 1;
+  else
+    dwt_count = sizeof dwt_names / sizeof *dwt_names;
+
+  return dwt_count;
+}
+
+
+/**************************************************************************//**
+ * @brief Reset & start the DWT counters
+ * @param none
+ * @return none
+ */
+static void dwtStart(void) {
+  DWT->CYCCNT = 0;
+  if(dwt_count > 1) {
+    DWT->CPICNT = 0;
+    DWT->EXCCNT = 0;
+    DWT->SLEEPCNT = 0;
+    DWT->LSUCNT = 0;
+    DWT->FOLDCNT = 0;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk | DWT_PRF_ENA_MSK;
+  } else {
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+  }
+}
+
+
+/**************************************************************************//**
+ * @brief Stop the DWT counters & read the counts
+ * @param uint32_t* - count of each counter
+ * @return none
+ */
+static void dwtStop(uint32_t* counts) {
+  DWT->CTRL &= ~(DWT_CTRL_CYCCNTENA_Msk | DWT_PRF_ENA_MSK);
+
+  counts[0] = DWT->CYCCNT;
+  if(dwt_count > 1) {
+    counts[1] = DWT->CPICNT & 0xFF;
+    counts[2] = DWT->EXCCNT & 0xFF;
+    counts[3] = DWT->SLEEPCNT & 0xFF;
+    counts[4] = DWT->LSUCNT & 0xFF;
+    counts[5] = DWT->FOLDCNT & 0xFF;
+  }
+}
+
+#endif /* #if defined(RET_TEST) && !defined(RET_HOST) */
@@ -0,0 +1,136 @@
+/**************************************************************************//**
+ * @file ret_perf_linux.c
+ * @brief RET performance counter port for Linux hosts (perf_event_open)
+ *
+ * The counters are opened as one group so that all counts cover exactly the
+ * same instructions.  Counting is restricted to user space, which works with
+ * the default perf_event_paranoid setting.  Events that cannot be opened
+ * (ie: inside a virtual machine) are left out of the group; if no event can
+ * be opened RET reports that counters are unavailable.
+ */
+#if defined(RET_TEST) && defined(__linux__)
+
+#define _GNU_SOURCE
+#include <stdint.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+#include "ret_perf.h"
+
+
+/******************************************************************************
+* S T A T I C    D A T A
+******************************************************************************/
+/**
+ * @brief Hardware events in report order
+ */
+static const struct {
+  uint64_t    config;
+  const char* name;
+} perf_events[] = {
+  {PERF_COUNT_HW_CPU_CYCLES,    "cycles"},
+  {PERF_COUNT_HW_INSTRUCTIONS,  "instructions"},
+  {PERF_COUNT_HW_CACHE_MISSES,  "cache-misses"},
+  {PERF_COUNT_HW_BRANCH_MISSES, "branch-misses"},
+};
+
+#define PERF_EVENT_COUNT  (sizeof perf_events / sizeof *perf_events)
+
+/**
+ * @brief Open counter group
+ */
+static struct {
+  int         fd[PERF_EVENT_COUNT]; /**< Event descriptors (first is leader) */
+  uint32_t    count; /**< Number of open events */
+  const char* names[PERF_EVENT_COUNT]; /**< Names of the open events */
+} perf;
+
+
+/******************************************************************************
+* S T A T I C    F U N C T I O N    P R O T O T Y P E S
+******************************************************************************/
+static uint32_t perfOpen  (void);
+static void     perfStart (void);
+static void     perfStop  (uint32_t* counts);
+
+
+/******************************************************************************
+* P U B L I C    D A T A
+******************************************************************************/
+const ret_perf_port_t ret_perf_linux = {
+  perfOpen, perfStart, perfStop, perf.names
+};
+
+
+/**************************************************************************//**
+ * @brief Open the counter group (once per process)
+ * @param none
+ * @return uint32_t - number of counters available
+ */
+static uint32_t perfOpen(void) {
+  struct perf_event_attr attr;
+  uint32_t n;
+  int      fd;
+
+  if(perf.count != 0)
+    return perf.count;
+
+  for(n = 0; n < PERF_EVENT_COUNT; n++) {
+    memset(&attr, 0, sizeof attr);
+    attr.size = sizeof attr;
+    attr.type = PERF_TYPE_HARDWARE;
+    attr.config = perf_events[n].config;
+    attr.disabled = (perf.count == 0); /* Leader controls the group */
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    attr.read_format = PERF_FORMAT_GROUP;
+
+    fd = (int)syscall(SYS_perf_event_open, &attr, 0, -1,
+                      (perf.count == 0) ? -1 : perf.fd[0], 0);
+    if(fd < 0)
+      continue;
+    perf.fd[perf.count] = fd;
+    perf.names[perf.count++] = perf_events[n].name;
+  }
+  return perf.count;
+}
+
+
+/**************************************************************************//**
+ * @brief Reset & start the counter group
+ * @param none
+ * @return none
+ */
+static void perfStart(void) {
+  ioctl(perf.fd[0], PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+  ioctl(perf.fd[0], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+}
+
+
+/**************************************************************************//**
+ * @brief Stop the counter group & read the counts (saturated to 32 bits)
+ * @param uint32_t* - count of each open event
+ * @return none
+ */
+static void perfStop(uint32_t* counts) {
+  uint64_t values[1 + PERF_EVENT_COUNT];
+  uint32_t n;
+
+  ioctl(perf.fd[0], PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+  memset(values, 0, sizeof values);
+  if(read(perf.fd[0], values, sizeof values) < 0)
+    values[0] = 0;
+
+  /* PERF_FORMAT_GROUP: number of events followed by the event counts */
+  for(n = 0; n < perf.count; n++) {
+    if(n >= values[0])
+      counts[n] = 0;
+    else
+      counts[n] = (values[1 + n] > UINT32_MAX) ? UINT32_MAX :
+                  (uint32_t)values[1 + n];
+  }
+}
+
+#endif /* #if defined(RET_TEST) && defined(__linux__) */
@@ -0,0 +1,63 @@
+/**************************************************************************//**
+ * @file ret_resume_mmap.c
+ * @brief RET resume record of host builds in a memory-mapped file
+ *
+ * Provides retHostResumeRecord() for a host build with RET_RESUME defined.
+ * The record is a shared mapping of the file named by the RET_RESUME_FILE
+ * environment variable (default ret_resume.bin), so it survives a crashed
+ * or killed test process like .noinit RAM survives a target reset.
+ */
+#if defined(RET_TEST) && defined(RET_HOST) && defined(RET_RESUME)
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdlib.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include "ret.h"
+
+
+/******************************************************************************
+* S T A T I C    D A T A
+******************************************************************************/
+static void*    resume_record;
+static uint32_t resume_size;
+
+#define RESUME_FILE_DEFAULT "ret_resume.bin"
+
+
+/**************************************************************************//**
+ * @brief Map the resume record file (created on first use)
+ * @param uint32_t - size of the record
+ * @return void* - record or NULL if the file cannot be mapped
+ */
+void* retHostResumeRecord(uint32_t size) {
+  const char* path;
+  int fd;
+
+  if((resume_record != NULL) && (resume_size == size))
+    return resume_record;
+  if(resume_record != NULL)
+    munmap(resume_record, resume_size);
+  resume_record = NULL;
+
+  path = getenv("RET_RESUME_FILE");
+  if(path == NULL)
+    path = RESUME_FILE_DEFAULT;
+  fd = open(path, O_RDWR | O_CREAT, 0644);
+  if(fd < 0)
+    return NULL;
+
+  /* A new (or resized) file reads as zeros - an invalid record */
+  if(ftruncate(fd, size) == 0) {
+    resume_record = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if(resume_record == MAP_FAILED)
+      resume_record = NULL;
+  }
+  close(fd);
+  resume_size = size;
+  return resume_record;
+}
+
+#endif /* #if defined(RET_TEST) && defined(RET_HOST) && defined(RET_RESUME) */
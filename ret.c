@@ -25,7 +25,16 @@
 extern "C" {
 #endif
 
+#if defined(RET_SIGNAL) && !defined(_XOPEN_SOURCE)
+#define _XOPEN_SOURCE 700 /* sigaction, sigaltstack & sigsetjmp */
+#endif
 #include "ret.h"
+#ifdef RET_RESUME
+#include <stddef.h>
+#endif
+#ifdef RET_SIGNAL
+#include <signal.h>
+#endif
 
 
 /******************************************************************************
@@ -35,17 +44,138 @@ extern "C" {
  * @brief Setjmp/longjmp environment for nested calls into retExecuteList
  */
 typedef struct {
+#ifdef RET_SIGNAL
+  sigjmp_buf env; /**< sigsetjmp environment (signal handlers jump to it) */
+#else
   jmp_buf   env; /**< setjmp environment as per compiler */
+#endif
   char*     tag_ptr; /**< pointer to the end of the test tag at this nest level */
   uint32_t  timer; /**< start time for elapsed time calculation of nest level */
+  uint32_t  io_mark; /**< ret.io_time at the start of the timer */
+#ifdef RET_VIRTUAL_CLOCK
+  uint32_t  vtimer; /**< Virtual start time (see RET_VIRTUAL_CLOCK) */
+#endif
+  const ret_test_t* test; /**< Test executing at this nest level */
+  uint32_t  case_index; /**< Case of the test executing at this nest level */
+  uint32_t  pass; /**< Passed leaves below the tests of this nest level */
+  uint32_t  fail; /**< Failed leaves below the tests of this nest level */
+  uint32_t  skip; /**< Skipped leaves below the tests of this nest level */
+  uint32_t  child_time; /**< Total net time of the tests of this level */
+  uint32_t  child_max; /**< Maximum net time of the tests of this level */
+  bool      is_overlap; /**< Async tests of this level overlapped */
 } ret_env_t;
 
+/**
+ * @brief Async leaf waiting to be resumed by the scheduler
+ */
+typedef struct {
+  const ret_test_t* test; /**< Waiting test */
+  uint32_t    case_index; /**< Case of a parameterized test */
+  uint32_t    timer; /**< start time for elapsed time calculation */
+  uint32_t    io_mark; /**< ret.io_time at the start of the timer */
+#ifdef RET_VIRTUAL_CLOCK
+  uint32_t    vtimer; /**< Virtual start time */
+  bool        is_virtual; /**< Last poll read the virtual clock */
+#endif
+#ifdef RET_RESUME
+  uint32_t    path_hash; /**< Hash of the tag path (see retResumeEnter) */
+#endif
+  uint32_t    perf[RET_PERF_MAX_COUNTERS]; /**< Counts of the polls so far */
+#ifdef RET_COVERAGE
+  void*       cov_funcs[RET_COVERAGE_MAX_FUNCS]; /**< Called by the polls */
+  uint32_t    cov_count; /**< Functions in cov_funcs[] */
+  bool        cov_full; /**< More functions than cov_funcs[] */
+#endif
+  ret_async_t ctx; /**< Resume point & timeout passed via param->async */
+} ret_async_slot_t;
+
 /**
  * @brief Test function that executes the test branches (feel free to rename)
  */
 extern ret_retval_t RunTrunk(ret_param_t *param);
 
 
+/**
+ * @brief Soak statistics of a leaf (see soak mode in ret.h)
+ */
+typedef struct {
+  char        tag[RET_MAX_TAG_STRING_SIZE]; /**< Tag path of the leaf */
+  uint32_t    pass; /**< Passed executions */
+  uint32_t    fail; /**< Failed executions */
+  uint32_t    first_fail; /**< First failed iteration (0 = none) */
+  uint32_t    max_time; /**< Maximum elapsed time */
+  uint32_t    max_net; /**< Maximum net time */
+  uint32_t    hist[RET_SOAK_HIST_SIZE]; /**< Net time histogram */
+} ret_soak_stat_t;
+
+#ifdef RET_TRACE
+/**
+ * @brief Execution trace event (see RET_TRACE in ret.h)
+ */
+typedef struct {
+  uint32_t    time; /**< RET_TRACE_TICK_FUNC() timestamp */
+  const char* name; /**< Tag, file or user span name (string constant) */
+  uint32_t    arg; /**< Case index or line number */
+  char        event; /**< 'B'egin, 'E'nd or 'I'nstant */
+  uint8_t     nest; /**< Recursion level into retExecuteList() */
+} ret_trace_event_t;
+#endif
+
+#ifdef RET_VIRTUAL_CLOCK
+/**
+ * @brief Virtual timer (see retClockTimer)
+ */
+typedef struct {
+  ret_timer_func_t* func; /**< Expiry callback (NULL = timer free) */
+  void*       arg; /**< Callback argument */
+  uint32_t    deadline; /**< Virtual time of the next expiry */
+  uint32_t    period; /**< Reload period (0 = one-shot) */
+  uint32_t    order; /**< Start order (fires first on equal deadlines) */
+  const ret_test_t* owner; /**< Test that started the timer or NULL */
+  uint32_t    case_index; /**< Case of a parameterized owner */
+} ret_timer_t;
+#endif
+
+#ifdef RET_FAIL_LOG
+/**
+ * @brief Held information line (followed by the message string)
+ */
+typedef struct {
+  const ret_test_t* test; /**< Test that reported the line */
+  uint32_t    case_index; /**< Case of a parameterized test */
+  uint32_t    len; /**< Message length including the terminator */
+  uint32_t    dropped; /**< Later lines of the test that did not fit */
+} ret_log_entry_t;
+#endif
+
+#ifdef RET_RESUME
+/**
+ * @brief Leaf counts of a nest level
+ */
+typedef struct {
+  uint32_t    pass;
+  uint32_t    fail;
+  uint32_t    skip;
+} ret_resume_count_t;
+
+/**
+ * @brief Run progress record that survives a reset (see RET_RESUME in ret.h)
+ */
+typedef struct {
+  uint32_t    magic; /**< RET_RESUME_MAGIC */
+  uint32_t    selection; /**< Hash of param->test_tag */
+  uint32_t    line_number; /**< Next report line number */
+  ret_resume_count_t run; /**< Leaf counts of the run */
+  ret_resume_count_t level[RET_MAX_NEST_SIZE]; /**< Rollup of each level */
+  uint32_t    is_done; /**< Test of tag completed */
+  char        tag[RET_MAX_TAG_STRING_SIZE]; /**< Last test entered/completed */
+  uint32_t    parked_count; /**< Async leaves waiting */
+  uint32_t    parked[RET_MAX_ASYNC_SIZE]; /**< Tag path hashes of the leaves */
+  uint32_t    checksum; /**< Hash of the record up to the checksum */
+} ret_resume_t;
+#endif
+
+
 /******************************************************************************
 * S T A T I C   D A T A
 ******************************************************************************/
@@ -57,6 +187,22 @@ static struct {
   char      tag_str[RET_MAX_TAG_STRING_SIZE]; /**< current test string */
   char*     tag_ptr; /**< test string end position for retRemoveTag() */
   uint32_t  nest; /**< Recursion level into retExecuteList() */
+  uint32_t  sel_len; /**< Length of the tag portion of param->test_tag */
+  uint32_t  sel_first; /**< First selected case of a tag[first-last] range */
+  uint32_t  sel_last; /**< Last selected case of a tag[first-last] range */
+  bool      sel_range; /**< param->test_tag selects a range of cases */
+  uint32_t  async_count; /**< Number of async leaves waiting in ret_async[] */
+  uint32_t  timer; /**< start time for elapsed time calculation of the run */
+  uint32_t  pass; /**< Passed leaves of the run */
+  uint32_t  fail; /**< Failed leaves of the run */
+  uint32_t  skip; /**< Skipped leaves of the run */
+  uint32_t  io_time; /**< Time spent formatting & sending the report (and
+                          preparing caches, see ret_cache_t) */
+  uint32_t  io_timer; /**< Start time of the report output in progress */
+  uint32_t  io_depth; /**< Nesting of report output (timed at depth 1) */
+  uint32_t  order_seed; /**< Test order seed of the run (0 = list order) */
+  uint32_t  blocked_nest; /**< Nest level of a blocked test whose subtree is
+                               walked for its leaf counts (0 = none) */
 } ret;
 
 /**
@@ -68,49 +214,283 @@ static struct {
   bool  is_pause; /**< flag to control when the output buffer is sent  */
 } ret_buf;
 
+#ifdef RET_TRACE
+/**
+ * @brief Static execution trace buffer
+ */
+static struct {
+  ret_trace_event_t events[RET_TRACE_BUF_SIZE]; /**< Captured events */
+  uint32_t  count; /**< Number of captured events */
+  uint32_t  dropped; /**< Events lost to a full buffer */
+  bool      is_sending; /**< Trace is being sent (flushes not captured) */
+} ret_trace;
+
+/* Internal trace hook (empty without RET_TRACE) */
+#define RET_TRACE_EVENT(event, name, arg) retTraceEvent((event), (name), (arg))
+#else
+#define RET_TRACE_EVENT(event, name, arg)
+#endif
+
 /**
  * @brief Root test
  *
  * RunTrunk is the top level test function that runs each test branch via
  * retExecuteList.  The root tag prefixes every node of the test tree.
  */
-static ret_test_t root[] = {
-  {RunTrunk, RET_ROOT_TAG}
+static const ret_test_t root[] = {
+  {RunTrunk, RET_ROOT_TAG, NULL, sizeof RET_ROOT_TAG - 1, NULL}
 };
 
 /**
  * @brief Root test list (DO NOT EDIT)
  */
-static ret_list_t root_list = { 1, root };
+static const ret_list_t root_list = { 1, root };
 
 /**
  * @brief Array of setjmp environments indexed via ret.nest variable
  */
 static ret_env_t   ret_env[RET_MAX_NEST_SIZE];
 
+/**
+ * @brief Async leaves waiting for the scheduler (stacked by nest level)
+ */
+static ret_async_slot_t ret_async[RET_MAX_ASYNC_SIZE];
+
+/**
+ * @brief Static performance counter control (see retSetPerfPort)
+ */
+static struct {
+  const ret_perf_port_t* port; /**< Counter port or NULL */
+  uint32_t  count; /**< Counters available for this run (0 = none) */
+  uint32_t  counts[RET_PERF_MAX_COUNTERS]; /**< Counts of the last test */
+  uint32_t  carry[RET_PERF_MAX_COUNTERS]; /**< Counts of the earlier polls
+                                              of the reported async leaf */
+} ret_perf;
+
+/**
+ * @brief Static cache state control (see ret_cache_t & retSetCachePort)
+ */
+static struct {
+  const ret_cache_port_t* port; /**< Flush port or NULL */
+  bool      is_ready; /**< Port opened for this run */
+  bool      is_rehearsal; /**< A leaf is being rehearsed (RET_CACHE_WARM) */
+  uint32_t  start; /**< Start time of the flush or rehearsal */
+  uint32_t  io_time; /**< ret.io_time at the start */
+#ifdef RET_VIRTUAL_CLOCK
+  uint32_t  vnow; /**< Virtual time at the start */
+#endif
+} ret_cache;
+
+/**
+ * @brief Static failed test tags of the run (see ret_test_t deps)
+ */
+static struct {
+  const char* tags[RET_MAX_FAILED_TAGS]; /**< Tags of failed tests */
+  uint32_t  count; /**< Number of tags in tags[] */
+  const char* last; /**< Tag of the last failed test (fail_fast cause) */
+} ret_dep;
+
+/**
+ * @brief Static soak iteration control & leaf statistics
+ */
+static struct {
+  bool      is_active; /**< Soak mode run */
+  uint32_t  iteration; /**< Current iteration (from 1) */
+  uint32_t  report_timer; /**< Start time of the progress report period */
+  uint32_t  count; /**< Number of leaves in stats[] */
+  uint32_t  untracked; /**< Leaf executions not tracked (stats[] full) */
+  ret_soak_stat_t stats[RET_SOAK_MAX_TESTS]; /**< Leaf statistics */
+} ret_soak;
+
+#ifdef RET_COVERAGE
+/**
+ * @brief Static coverage map of the tests at each nest level (see ret.h)
+ */
+static struct {
+  void*     funcs[RET_MAX_NEST_SIZE][RET_COVERAGE_MAX_FUNCS]; /**< Called */
+  uint32_t  count[RET_MAX_NEST_SIZE]; /**< Functions in funcs[] */
+  bool      is_full[RET_MAX_NEST_SIZE]; /**< More functions than funcs[] */
+} ret_cov;
+
+/* Number of function offsets per C line */
+#define RET_COVERAGE_LINE_FUNCS 8
+#endif
+
+#ifdef RET_VIRTUAL_CLOCK
+/**
+ * @brief Static virtual clock & timers (see RET_VIRTUAL_CLOCK in ret.h)
+ */
+static struct {
+  uint32_t  now; /**< Virtual time */
+  uint32_t  order; /**< Start order of the next timer */
+  uint32_t  reads; /**< Calls of retClockNow() & retClockSleep() */
+  uint32_t  poll_mark; /**< reads at the start of the last test call */
+  ret_timer_t timers[RET_CLOCK_MAX_TIMERS]; /**< Timer pool */
+} ret_clock;
+
+/* Internal virtual time report hook (empty without RET_VIRTUAL_CLOCK) */
+#define RET_CLOCK_LINE(retval, level) retClockLineFormat((retval), (level))
+#else
+#define RET_CLOCK_LINE(retval, level)
+#endif
+
+#ifdef RET_FAIL_LOG
+/**
+ * @brief Static failure-only information log (see RET_FAIL_LOG in ret.h)
+ */
+static struct {
+  char      buf[RET_FAIL_LOG_SIZE]; /**< Held lines (ret_log_entry_t + msg) */
+  uint32_t  size; /**< Bytes of buf in use */
+  uint32_t  lost; /**< Dropped lines of tests without a held line */
+  uint32_t  discarded; /**< Lines of passed tests discarded by the run */
+  bool      is_active; /**< Lines are held (not a search) */
+} ret_log;
+#endif
+
+#ifdef RET_SIGNAL
+/**
+ * @brief Static fault recovery control (see RET_SIGNAL in ret.h)
+ */
+static struct {
+  char      stack[RET_SIGNAL_STACK_SIZE]; /**< Alternate signal stack */
+  stack_t   save_stack; /**< Alternate stack before retStart() */
+  struct sigaction save_action[3]; /**< Handlers before retStart() */
+  int       sig; /**< Signal of the last fault */
+  void*     addr; /**< Faulting address of the last fault */
+} ret_signal;
+
+/* Signals handled in RET_SIGNAL builds */
+static const int RET_SIGNALS[3] = {SIGSEGV, SIGFPE, SIGBUS};
+
+/* The signal mask is not saved (handlers are SA_NODEFER) */
+#define RET_SETJMP(env)           sigsetjmp((env), 0)
+#define RET_LONGJMP(env, val)     siglongjmp((env), (val))
+#else
+#define RET_SETJMP(env)           setjmp(env)
+#define RET_LONGJMP(env, val)     longjmp((env), (val))
+#endif
+
+#ifdef RET_RESUME
+#ifndef RET_HOST
+/**
+ * @brief Progress record (not initialized at reset)
+ */
+static ret_resume_t ret_resume_record RET_NOINIT;
+#endif
+
+/**
+ * @brief Static resume control (see RET_RESUME in ret.h)
+ */
+static struct {
+  ret_resume_t* record; /**< Progress record or NULL (not recorded) */
+  bool      is_resuming; /**< Skipping the tests completed before a reset */
+  bool      is_skipped; /**< Entered test was completed before the reset */
+  bool      is_crashed; /**< Entered test was running at the reset */
+  uint32_t  parked_count; /**< Async leaves waiting at the reset */
+  uint32_t  parked[RET_MAX_ASYNC_SIZE]; /**< Tag path hashes of the leaves */
+} ret_resume;
+
+#define RET_RESUME_MAGIC      0x52455452 /* "RETR" */
+#define RET_RESUME_SKIPPED()  retResumeSkipped()
+#else
+#define RET_RESUME_SKIPPED()  false
+#endif
+
 /* Const data */
 static const char* RET_TAG_ERR_MSG = "Error: RET_MAX_TAG_STRING_SIZE exceeded";
 static const char* RET_LAYER_ERR_MSG = "Error: RET_MAX_NEST_SIZE exceeded";
 static const char* RET_PATH_ERR_MSG = "test path not found";
+static const char* RET_CASES_ERR_MSG = "Error: empty case table";
 static const char* RET_TEST_DONE_MSG = "DONE";
-static const char* RET_RETVAL_STR[4] = {"PASS", "FAIL", "TIMEOUT", "TAG_ID"};
+static const char* RET_PERF_ERR_MSG = "performance counters unavailable";
+static const char* RET_CACHE_ERR_MSG = "cache flush unavailable";
+static const char* RET_ORDER_MSG = "order seed: ";
+static const char* RET_BLOCKED_MSG = "blocked by: ";
+#ifdef RET_FAIL_LOG
+static const char* RET_LOG_DROP_MSG = "log truncated: ";
+static const char* RET_LOG_DROP_END_MSG = " lines dropped";
+static const char* RET_LOG_DISCARD_MSG = "info lines of passed tests discarded: ";
+#endif
+#ifdef RET_RESUME
+static const char* RET_RESUME_MSG = "resumed after reset";
+#endif
+#ifdef RET_SIGNAL
+static const char* RET_SIGNAL_MSG = "fault: signal ";
+static const char* RET_SIGNAL_ADDR_MSG = " at 0x";
+#endif
+#ifdef RET_TRACE
+static const char* RET_TRACE_FLUSH_MSG = "flush";
+static const char* RET_TRACE_NAME_MSG = "trace";
+#endif
+static const char* RET_RETVAL_STR[8] = {"PASS", "FAIL", "TIMEOUT", "TAG_ID",
+                                        "PENDING", "CRASH", "FAULT",
+                                        "BLOCKED"};
 static const char  RET_DIGITS[16] = {'0', '1', '2', '3', '4', '5', '6', '7',
                                      '8', '9', 'a', 'b', 'c', 'd', 'e', 'f'};
 /* DO NOT USE THIS CHARACTER IN A TEST FUNCTION TAG! */
 #define RET_TOKEN_DELIMITER '@'
+/* Delimiters of the case index appended to parameterized test tags */
+#define RET_CASE_OPEN         '['
+#define RET_CASE_CLOSE        ']'
+#define RET_CASE_RANGE        '-'
+/* Size of a case suffix string (ie: "[4294967295-4294967295]") */
+#define RET_CASE_STR_SIZE     24
 
 
 /******************************************************************************
 * S T A T I C    F U N C T I O N    P R O T O T Y P E S
 ******************************************************************************/
-static ret_retval_t  retEnter            (ret_param_t* param, ret_test_t* test);
+static ret_retval_t  retEnter            (ret_param_t* param,
+                                       const ret_test_t* test,
+                                       const char* blocked_by);
 static void       retExit             (ret_param_t* param, ret_retval_t retval);
 static bool       retFindTagToken     (ret_param_t *param);
-static ret_retval_t retAddTag(const char* const tag);
+static void       retAsyncPark        (ret_param_t* param,
+                                       const ret_test_t* test);
+static ret_retval_t retAsyncSchedule  (ret_param_t* param, uint32_t first_slot,
+                                       uint32_t max_waiting);
+static ret_retval_t retAsyncResume    (ret_param_t* param, uint32_t slot);
+static ret_retval_t retAddTag         (const ret_test_t* test,
+                                       const char* const suffix);
+static void       retCaseSuffix       (char* dst_buf, ret_param_t* param,
+                                       const ret_test_t* test);
+static void       retParseSelector    (const char* test_tag);
+static bool       retParseDecimal     (const char** str, uint32_t* value);
 static void       retRemoveTag        (uint32_t nest_val);
-static void       retTestLineFormat   (ret_retval_t retval, uint32_t elapsed_time);
+static void       retTestLineFormat   (ret_retval_t retval, uint32_t elapsed_time,
+                                       uint32_t net_time);
+static void       retBranchLineFormat (ret_retval_t retval, uint32_t elapsed_time,
+                                       uint32_t net_time, ret_env_t* children);
+static void       retSummaryLineFormat(ret_param_t* param);
+static void       retRollup           (ret_param_t* param, ret_retval_t retval,
+                                       bool executed, uint32_t elapsed_time,
+                                       uint32_t net_time);
+static void       retClearRollup      (void);
+static void       retDone             (ret_param_t* param);
+static bool       retSoakNext         (ret_param_t* param);
+static void       retSoakRecord       (ret_retval_t retval, uint32_t elapsed_time,
+                                       uint32_t net_time);
+static void       retSoakLineFormat   (ret_param_t* param);
+static void       retSoakStatLineFormat(ret_soak_stat_t* stat);
+static void       retPerfLineFormat   (ret_retval_t retval, uint32_t elapsed_time,
+                                       uint32_t net_time);
+static uint32_t   retNetTime          (uint32_t elapsed_time, uint32_t io_mark);
+static void       retPerfPause        (uint32_t* total);
+static uint32_t   retOrderKey         (void);
+static uint32_t   retOrderIndex       (uint32_t key, uint32_t size,
+                                       uint32_t n);
+static void       retOrderLine        (void);
+static void       retCachePrepare     (ret_param_t* param,
+                                       const ret_test_t* test);
+static void       retCacheEnd         (void);
+static const char* retDepFailed       (const ret_test_t* test);
+static void       retDepRecord        (const char* tag, ret_retval_t retval);
+static void       retDepLine          (const char* tag);
+static void       retIoBegin          (void);
+static void       retIoEnd            (void);
 
 static void       retDecimalDigits    (uint32_t value, uint32_t width);
+static void       retPutDecimal       (uint32_t value);
 
 static void retPutChar(const char printable_ascii);
 static void retPutString(const char* out_string);
@@ -118,9 +498,60 @@ static void       retPutLineFeed      (void);
 static void       retPutCommaSeparator(void);
 static void       retSendBuffer       (void);
 static void retSearchLine(const char* tag);
+#ifdef RET_TRACE
+static void       retTraceSend        (void);
+static void       retTraceLineFormat  (ret_trace_event_t* trace);
+#endif
+#ifdef RET_COVERAGE
+static void       retCoverageLineFormat(uint32_t level);
+static void       retCoverageSave     (ret_async_slot_t* slot);
+static void       retCoverageRestore  (const ret_async_slot_t* slot);
+#endif
+#ifdef RET_VIRTUAL_CLOCK
+static void       retClockAdvance     (uint32_t target);
+static void       retClockCancelOwner (ret_env_t* level);
+static void       retClockLineFormat  (ret_retval_t retval, ret_env_t* level);
+#endif
+#ifdef RET_FAIL_LOG
+static void       retLogAppend        (const char* str);
+static void       retLogRelease       (ret_env_t* level, bool flush);
+static void       retLogCountLine     (const char* msg, uint32_t count,
+                                       const char* end_msg);
+#endif
+#ifdef RET_RESUME
+static void       retResumeStart      (ret_param_t* param);
+static bool       retResumeEnter      (void);
+static bool       retResumeSkipped    (void);
+static void       retResumeRecord     (bool is_done);
+static uint32_t   retResumeHash       (const void* data, uint32_t size);
+#endif
+#ifdef RET_SIGNAL
+static void       retSignalInstall    (void);
+static void       retSignalRestore    (void);
+static void       retSignalHandler    (int sig, siginfo_t* info, void* context);
+static ret_retval_t retSignalFault    (void);
+#endif
 static void retFormatLine(char msg_type, const char* str, bool pause);
 
 
+/**************************************************************************//**
+ * @brief Zero the user control structure & set the test to run
+ *
+ * The other user elements are left at their defaults (soak, test order,
+ * cache & fail fast options off, full report).
+ *
+ * @param ret_param_t* - pointer to user control structure
+ * @param ret_mode_t - RET_MODE_EXE or RET_MODE_SEARCH
+ * @param char* - user test string
+ * @return none
+ */
+void retParamInit(ret_param_t* param, ret_mode_t mode, char* test_tag) {
+  memset(param, 0, sizeof *param);
+  param->mode = mode;
+  param->test_tag = test_tag;
+}
+
+
 /**************************************************************************//**
  * @brief Initialize & start test engine
  * @param ret_param_t* - pointer to user control structure
@@ -128,16 +559,202 @@ static void retFormatLine(char msg_type, const char* str, bool pause);
  */
 void retStart(ret_param_t* param) {
   ret.next_line_number = 0;
-  ret.tag_str[0] = '\0'; /* empty tag string at start of test */
-  ret.tag_ptr = ret.tag_str;
-  ret.nest = 0;
+  ret.timer = RET_SYS_TICK_FUNC();
+  ret.pass = 0;
+  ret.fail = 0;
+  ret.skip = 0;
+  ret.io_time = 0;
+  ret.io_depth = 0;
+#ifdef RET_TRACE
+  ret_trace.count = 0;
+  ret_trace.dropped = 0;
+  ret_trace.is_sending = false;
+#endif
+#ifdef RET_VIRTUAL_CLOCK
+  memset(&ret_clock, 0, sizeof ret_clock);
+#endif
+#ifdef RET_FAIL_LOG
+  ret_log.size = 0;
+  ret_log.lost = 0;
+  ret_log.discarded = 0;
+  ret_log.is_active = (param->mode != RET_MODE_SEARCH);
+#endif
   ret_buf.is_pause = RET_PAUSE;
   ret_buf.next_in = ret_buf.buf;
   param->tag_found = 0;
   param->retval = 0;
+  param->test_case = NULL;
+  param->case_index = 0;
+  retParseSelector(param->test_tag);
+  ret_soak.is_active = (param->soak_count != 0) || (param->soak_time != 0);
+  ret_soak.iteration = 0;
+  ret_soak.report_timer = ret.timer;
+  ret_soak.count = 0;
+  ret_soak.untracked = 0;
+#ifdef RET_RESUME
+  retResumeStart(param);
+#endif
+  ret_perf.count = 0;
+  if(ret_perf.port != NULL) {
+    ret_perf.count = ret_perf.port->open();
+    if(ret_perf.count > RET_PERF_MAX_COUNTERS)
+      ret_perf.count = RET_PERF_MAX_COUNTERS;
+    if(ret_perf.count == 0)
+      retInfoLine(RET_PERF_ERR_MSG, RET_PAUSE);
+  }
+  ret_cache.is_rehearsal = false;
+  ret_cache.is_ready = false;
+  if(param->cache == RET_CACHE_COLD) {
+    if(ret_cache.port != NULL)
+      ret_cache.is_ready = ret_cache.port->open();
+    if(!ret_cache.is_ready)
+      retInfoLine(RET_CACHE_ERR_MSG, RET_PAUSE);
+  }
+  /* A search lists the tests in list order */
+  ret.order_seed = 0;
+  if(param->mode != RET_MODE_SEARCH) {
+    ret.order_seed = param->order_seed;
+    if(ret.order_seed != 0)
+      retOrderLine();
+  }
+
+#ifdef RET_SIGNAL
+  retSignalInstall();
+#endif
 
-  /* Start test */
-  retExecuteList(param, &root_list);
+  /* Start test (repeated in soak mode) */
+  do {
+    ret.tag_str[0] = '\0'; /* empty tag string at start of test */
+    ret.tag_ptr = ret.tag_str;
+    ret.nest = 0;
+    ret.async_count = 0;
+    ret.blocked_nest = 0;
+    ret_dep.count = 0;
+    ret_dep.last = NULL;
+    ret_soak.iteration++;
+    retExecuteList(param, &root_list);
+  } while(retSoakNext(param));
+
+#ifdef RET_SIGNAL
+  retSignalRestore();
+#endif
+  retDone(param);
+}
+
+
+/**************************************************************************//**
+ * @brief Send the end of test report
+ *
+ * @param ret_param_t* - pointer to user control structure
+ * @return none
+ */
+static void retDone(ret_param_t* param) {
+  uint32_t n;
+
+#ifdef RET_RESUME
+  /* Run completed - the next run starts from the root */
+  if(ret_resume.record != NULL)
+    ret_resume.record->magic = 0;
+#endif
+
+  /* param->tag_found is 0 if function tag not found */
+  if((param->tag_found == 0) && (strcmp(param->test_tag, RET_ROOT_TAG) != 0)) {
+    retInfoLine(RET_PATH_ERR_MSG, RET_PAUSE);
+    return;
+  }
+
+  /* Output test report */
+  if(ret_soak.is_active) {
+    retSoakLineFormat(param);
+    for(n = 0; n < ret_soak.count; n++)
+      retSoakStatLineFormat(&ret_soak.stats[n]);
+  } else if(param->report != RET_REPORT_FULL) {
+    retSummaryLineFormat(param);
+  }
+#ifdef RET_FAIL_LOG
+  /* Lines of tests that were not completed (ie: a failed branch function) */
+  retLogRelease(NULL, true);
+  if(ret_log.discarded != 0)
+    retLogCountLine(RET_LOG_DISCARD_MSG, ret_log.discarded, "");
+#endif
+#ifdef RET_TRACE
+  retTraceSend();
+#endif
+  retPutLineFeed();
+  retPutString(RET_TEST_DONE_MSG);
+  retSendBuffer();
+}
+
+
+/**************************************************************************//**
+ * @brief Determine if another soak iteration is due & report progress
+ * @param ret_param_t* - pointer to user control structure
+ * @return bool - true to run the selected tests again
+ */
+static bool retSoakNext(ret_param_t* param) {
+  uint32_t now;
+
+  if(!ret_soak.is_active)
+    return false;
+
+  now = RET_SYS_TICK_FUNC();
+  if(now - ret_soak.report_timer >= RET_SOAK_REPORT_TICKS) {
+    ret_soak.report_timer = now;
+    retSoakLineFormat(param);
+  }
+
+  if((param->soak_count != 0) && (ret_soak.iteration >= param->soak_count))
+    return false;
+  if((param->soak_time != 0) && (now - ret.timer >= param->soak_time))
+    return false;
+  return true;
+}
+
+
+/**************************************************************************//**
+ * @brief Add a leaf execution to the soak statistics
+ * @param ret_retval_t - return value of test
+ * @param uint32_t - elapsed time for test execution
+ * @param uint32_t - elapsed time less report output time
+ * @return none
+ */
+static void retSoakRecord(ret_retval_t retval, uint32_t elapsed_time,
+                          uint32_t net_time) {
+  ret_soak_stat_t* stat;
+  uint32_t bucket;
+
+  /* A leaf is identified by its tag path (a list may be executed by more
+   * than one branch) */
+  for(stat = ret_soak.stats; stat < ret_soak.stats + ret_soak.count; stat++) {
+    if(strcmp(stat->tag, ret.tag_str) == 0)
+      break;
+  }
+  if(stat == ret_soak.stats + RET_SOAK_MAX_TESTS) {
+    ret_soak.untracked++;
+    return;
+  }
+  if(stat == ret_soak.stats + ret_soak.count) {
+    memset(stat, 0, sizeof *stat);
+    memcpy(stat->tag, ret.tag_str, (size_t)(ret.tag_ptr - ret.tag_str) + 1);
+    ret_soak.count++;
+  }
+
+  if(retval == RET_PASS) {
+    stat->pass++;
+  } else {
+    if(stat->fail++ == 0)
+      stat->first_fail = ret_soak.iteration;
+  }
+  if(elapsed_time > stat->max_time)
+    stat->max_time = elapsed_time;
+  if(net_time > stat->max_net)
+    stat->max_net = net_time;
+
+  /* Bucket n counts times below 2^n (last bucket counts the rest) */
+  for(bucket = 0; (bucket < RET_SOAK_HIST_SIZE - 1) &&
+                  (net_time >= ((uint32_t)1 << bucket)); bucket++)
+    ;
+  stat->hist[bucket]++;
 }
 
 
@@ -147,12 +764,22 @@ void retStart(ret_param_t* param) {
  * @param ret_list_t* - pointer to test list structure (size + ret_test_t ptr)
  * @return ret_retval_t - see ret.h
  */
-ret_retval_t retExecuteList(ret_param_t* param, ret_list_t* list) {
+ret_retval_t retExecuteList(ret_param_t* param, const ret_list_t* list) {
   int         longjmp_val;
-  ret_test_t* test;
-  ret_test_t* last = list->first + list->size;
+  const ret_test_t* test;
   ret_retval_t   retval, err_flag;
   bool        save_pause;
+  /* Read after a longjmp to ret_env[ret.nest] (-Wclobbered) */
+  volatile bool save_fail_fast;
+  volatile ret_report_t save_report;
+  const char* volatile blocked_by;
+  volatile uint32_t case_count;
+  uint32_t    first_slot = ret.async_count;
+  uint32_t    n, key;
+
+  /* A branch rehearsed for RET_CACHE_WARM executes its list when timed */
+  if(ret_cache.is_rehearsal)
+    return RET_PASS;
 
   /* Prevent nesting beyond end of environment buffer (recursion limit) */
   if(ret.nest >= RET_MAX_NEST_SIZE) {
@@ -169,28 +796,80 @@ ret_retval_t retExecuteList(ret_param_t* param, ret_list_t* list) {
    */
   ret_env[ret.nest].tag_ptr = ret.tag_ptr;
 
-  for(test = list->first, err_flag = RET_PASS; test < last; test++) {
-    if((longjmp_val = setjmp(ret_env[ret.nest].env)) == 0) {
-      retval = retEnter(param, test);
-    } else {
-      /* longjmp value (cannot be zero) */
-      switch(longjmp_val) {
-        case -1:
-          /* value returned by retAssert() */
-          retval = RET_FAIL;
-          break;
+  /* List order or the order of the run's order seed */
+  key = (ret.order_seed != 0) ? retOrderKey() : 0;
+
+  for(n = 0, err_flag = RET_PASS; n < list->size; n++) {
+    test = list->first;
+    if(ret.order_seed != 0)
+      test += retOrderIndex(key, list->size, n);
+    else
+      test += n;
+
+    /* A parameterized leaf is a node per case (listed once by a search and
+     * entered once to report an empty case table) */
+    case_count = 1;
+    if((test->cases != NULL) && (test->cases->count != 0) &&
+       (param->mode != RET_MODE_SEARCH))
+      case_count = test->cases->count;
+
+    for(param->case_index = 0; param->case_index < case_count;
+        param->case_index++) {
+      /* Resume waiting async leaves until a scheduler slot is free */
+      if(retAsyncSchedule(param, first_slot,
+                          RET_MAX_ASYNC_SIZE - 1) != RET_PASS)
+        err_flag = RET_FAIL;
+
+      /* Report verbosity set by a branch applies to its own subtree */
+      save_report = param->report;
+      save_fail_fast = param->fail_fast;
+
+      /* The rest of a fail fast list is blocked by its first failure */
+      blocked_by = NULL;
+      if(param->fail_fast && (err_flag != RET_PASS))
+        blocked_by = ret_dep.last;
+      if((longjmp_val = RET_SETJMP(ret_env[ret.nest].env)) == 0) {
+        retval = retEnter(param, test, blocked_by);
+      } else {
+        /* longjmp value (cannot be zero) */
+        if(ret_cache.is_rehearsal)
+          retCacheEnd();
+        switch(longjmp_val) {
+          case -1:
+            /* value returned by retAssert() */
+            retval = RET_FAIL;
+            break;
+
+#ifdef RET_SIGNAL
+          case -2:
+            /* value returned by retSignalHandler() */
+            retval = retSignalFault();
+            break;
+#endif
 
-        default:
-          retval = RET_PASS;
-          break;
+          default:
+            retval = RET_PASS;
+            break;
+        }
       }
-    }
-    if(retval != RET_PASS)
-      err_flag = RET_FAIL;
+      if(retval == RET_PENDING) {
+        /* Async leaf is waiting - report when the scheduler completes it */
+        retAsyncPark(param, test);
+        continue;
+      }
+      if(retval != RET_PASS)
+        err_flag = RET_FAIL;
 
-    retExit(param, retval);
+      param->report = save_report;
+      param->fail_fast = save_fail_fast;
+      retExit(param, retval);
+    }
   }
 
+  /* Complete the async leaves of this list */
+  if(retAsyncSchedule(param, first_slot, first_slot) != RET_PASS)
+    err_flag = RET_FAIL;
+
   ret_buf.is_pause = save_pause;
   return(err_flag);
 }
@@ -210,21 +889,51 @@ ret_retval_t retExecuteList(ret_param_t* param, ret_list_t* list) {
  *
  * @param ret_param_t* - pointer to user control structure
  * @param ret_test_t* - pointer to test structure (func + tag)
+ * @param char* - tag of the failure that blocks the test (NULL = none)
  * @return ret_retval_t - see ret.h
  */
-static ret_retval_t retEnter(ret_param_t* param, ret_test_t* test) {
+static ret_retval_t retEnter(ret_param_t* param, const ret_test_t* test,
+                             const char* blocked_by) {
+  char case_str[RET_CASE_STR_SIZE];
+
+  /* Parameterized leaf: select the case and build its tag suffix */
+  case_str[0] = '\0';
+  param->test_case = NULL;
+  if(test->cases != NULL) {
+    retCaseSuffix(case_str, param, test);
+    if((param->mode != RET_MODE_SEARCH) && (test->cases->count != 0))
+      param->test_case = (const uint8_t*)test->cases->table +
+                         param->case_index * test->cases->size;
+  }
+
   /* Append tag of current function to end of the global tag path
    * Increment ret nesting value
    */
-  if(retAddTag(test->tag) == RET_ERR_TAG) {
+  if(retAddTag(test, case_str) == RET_ERR_TAG) {
     retInfoLineFmt(RET_TAG_ERR_MSG);
     return RET_ERR_TAG;
   }
+  ret_env[ret.nest - 1].test = test;
+  ret_env[ret.nest - 1].case_index = param->case_index;
+
+  /* Clear the rollup of the tests that this test may execute */
+  retClearRollup();
+#ifdef RET_COVERAGE
+  ret_cov.count[ret.nest - 1] = 0;
+  ret_cov.is_full[ret.nest - 1] = false;
+#endif
+#ifdef RET_RESUME
+  /* Tests completed before a reset are neither executed nor reported */
+  if((ret_resume.is_resuming || (ret_resume.parked_count != 0)) &&
+     !retResumeEnter())
+    return RET_PASS;
+#endif
 
   if(param->mode != RET_MODE_SEARCH) {
-    if(!retFindTagToken(param)) {
+    if(!retFindTagToken(param) || (ret.blocked_nest != 0)) {
       /* If test tag not present in global tag_str, skip leaf function
        * NB: Only leaf functions use the RET_MODE_SEARCH macro (permits skip)
+       * The subtree of a blocked test is skipped the same way
        */
       if(param->mode == RET_MODE_EXE)
         param->mode = RET_MODE_SKIP;
@@ -234,11 +943,58 @@ static ret_retval_t retEnter(ret_param_t* param, ret_test_t* test) {
        */
       if(param->mode == RET_MODE_SKIP)
         param->mode = RET_MODE_EXE;
+#ifdef RET_RESUME
+      retResumeRecord(false);
+#endif
+      if((blocked_by == NULL) && (test->deps != NULL))
+        blocked_by = retDepFailed(test);
+      if((blocked_by == NULL) && (param->cache != RET_CACHE_ASIS))
+        retCachePrepare(param, test);
 
       /* Get millisecond timer count from system (see ret.h) */
       ret_env[ret.nest - 1].timer = RET_SYS_TICK_FUNC();
+      ret_env[ret.nest - 1].io_mark = ret.io_time;
+#ifdef RET_VIRTUAL_CLOCK
+      ret_env[ret.nest - 1].vtimer = ret_clock.now;
+#endif
+      RET_TRACE_EVENT('B', test->tag, param->case_index);
+      if(ret_perf.count != 0) {
+        memset(ret_perf.carry, 0, sizeof ret_perf.carry);
+        ret_perf.port->start();
+      }
+
+      /* Parameterized leaf without cases - reported failed (ie: tag[]) */
+      if((test->cases != NULL) && (test->cases->count == 0)) {
+        retInfoLineFmt(RET_CASES_ERR_MSG);
+        return RET_FAIL;
+      }
+
+      /* Blocked - report the cause without executing the test.  A blocked
+       * branch walks its subtree in skip mode to count its leaves skipped.
+       */
+      if(blocked_by != NULL) {
+        retDepLine(blocked_by);
+        ret.blocked_nest = ret.nest;
+        param->mode = RET_MODE_SKIP;
+        (void)test->func(param);
+        param->mode = RET_MODE_EXE;
+        return RET_BLOCKED;
+      }
     }
   }
+#ifdef RET_RESUME
+  if(ret_resume.is_crashed) {
+    ret_resume.is_crashed = false;
+    return RET_CRASH;
+  }
+#endif
+
+  /* Fresh context for a leaf that turns out to be async (see retAsyncPark) */
+  param->async = &ret_async[ret.async_count].ctx;
+  memset(param->async, 0, sizeof *param->async);
+#ifdef RET_VIRTUAL_CLOCK
+  ret_clock.poll_mark = ret_clock.reads;
+#endif
 
   /* Execute test function */
   return(test->func(param));
@@ -257,28 +1013,44 @@ static ret_retval_t retEnter(ret_param_t* param, ret_test_t* test) {
  * @return none
  */
 static void retExit(ret_param_t* param, ret_retval_t retval) {
-  uint32_t elapsed_time;
+  uint32_t elapsed_time, n;
 
   if(retval == RET_ERR_TAG) {
     /* Tag length error
      * Do not decrement nesting since no corresponding increment
      */
-    retTestLineFormat(retval, 0);
+    retTestLineFormat(retval, 0, 0);
     return;
   }
 
-  if(retFindTagToken(param)) {
+  /* The walk of a blocked subtree ends with the blocked test */
+  if(ret.blocked_nest == ret.nest)
+    ret.blocked_nest = 0;
+
+  if(RET_RESUME_SKIPPED()) {
+    /* Completed before a reset (see RET_RESUME) */
+  } else if(retFindTagToken(param) && (ret.blocked_nest == 0)) {
     if(param->mode != RET_MODE_SEARCH) {
       /* Execution clean-up
        * All functions with test name in tag_str have been executed and
        * require timer cleanup and result reporting
        */
       elapsed_time = RET_SYS_TICK_FUNC() - ret_env[ret.nest - 1].timer;
-      retTestLineFormat(retval, elapsed_time);
+      if(ret_perf.count != 0) {
+        ret_perf.port->stop(ret_perf.counts);
+        for(n = 0; n < ret_perf.count; n++)
+          ret_perf.counts[n] += ret_perf.carry[n];
+      }
+      RET_TRACE_EVENT('E', ret_env[ret.nest - 1].test->tag,
+                      param->case_index);
+      retRollup(param, retval, true, elapsed_time,
+                retNetTime(elapsed_time, ret_env[ret.nest - 1].io_mark));
     } else {
       /* Search - return branches from supplied path */
       retSearchLine(ret.tag_str);
     }
+  } else if((param->mode != RET_MODE_SEARCH) && ret.nest) {
+    retRollup(param, retval, false, 0, 0);
   }
 
   /* If param->test_tag is the last segment of ret.tag_str then the requested
@@ -291,7 +1063,7 @@ static void retExit(ret_param_t* param, ret_retval_t retval) {
     /* NB: If the value passed to longjmp is 0, setjmp will behave as if it had
      *     returned 1
      */
-    longjmp(ret_env[0].env, retval);
+    RET_LONGJMP(ret_env[0].env, retval);
   }
 
   /* Return tag terminator to original position prior to current function call
@@ -299,80 +1071,763 @@ static void retExit(ret_param_t* param, ret_retval_t retval) {
    */
   if(ret.nest)
     retRemoveTag(ret.nest - 1);
-
-  if(ret.nest == 0) {
-    /* End of test
-     * param->tag_found is 0 if function tag not found
-     */
-    if((param->tag_found == 0) && (strcmp(param->test_tag, RET_ROOT_TAG) != 0))
-    {
-      retInfoLine(RET_PATH_ERR_MSG, RET_PAUSE);
-    } else {
-      /* Output test report */
-      retPutLineFeed();
-      retPutString(RET_TEST_DONE_MSG);
-      retSendBuffer();
-    }
-  }
 }
 
 
 /**************************************************************************//**
- * @brief Determine if the test tag is contained exactly in the constructed tag
+ * @brief Report a test and add its result to the rollup of its nest level
  *
- * Remove the last test tag from the executed test.  Jump to the root level
- * (test completed) if the param.tag is the last segment of ret.tag_str.  When
- * the root level calls this function the result buffer is sent to the host.
+ * A test whose own nest level rollup has leaf counts is a branch.  Leaves are
+ * counted as passed/failed or skipped (not executed).  The report depends on
+ * param->report (see ret.h).
  *
  * @param ret_param_t* - pointer to user control structure
- * @return ret_retval_t - see ret.h
+ * @param ret_retval_t - return value of test
+ * @param bool - true if the test was executed
+ * @param uint32_t - elapsed time for test execution
+ * @param uint32_t - elapsed time less report output time
+ * @return none
  */
-static bool retFindTagToken(ret_param_t *param) {
-  char* tag_pos;
+static void retRollup(ret_param_t* param, ret_retval_t retval, bool executed,
+                      uint32_t elapsed_time, uint32_t net_time) {
+  ret_env_t* level = &ret_env[ret.nest - 1];
+  ret_env_t* children = NULL;
+
+  if(ret.nest < RET_MAX_NEST_SIZE) {
+    children = &ret_env[ret.nest];
+    if(children->pass + children->fail + children->skip == 0)
+      children = NULL;
+  }
 
-  /* Check if the test string is a ret.tag_str token
-   * Check character beyond end of test string since it may be a subset
-   * of a larger tag (ie: ...@testXXX@... and ...@testXXXConfig@...)
-   */
-  tag_pos = strstr(ret.tag_str, param->test_tag);
-  if((tag_pos == NULL) ||
-      ((*(tag_pos + strlen(param->test_tag)) != RET_TOKEN_DELIMITER) &&
-      (*(tag_pos + strlen(param->test_tag)) != '\0'))) {
-    return false;
+  if(children != NULL) {
+    /* Branch - add the leaves of its subtree */
+    level->pass += children->pass;
+    level->fail += children->fail;
+    level->skip += children->skip;
+  } else if(!executed || (retval == RET_BLOCKED)) {
+    level->skip++;
+    ret.skip++;
+  } else if(retval == RET_PASS) {
+    level->pass++;
+    ret.pass++;
   } else {
-    /* Increment flag to indicate path tag_found */
-    param->tag_found++;
-    return true;
+    level->fail++;
+    ret.fail++;
+  }
+#ifdef RET_FAIL_LOG
+  retLogRelease(level, executed && (retval != RET_PASS));
+#endif
+#ifdef RET_RESUME
+  retResumeRecord(true);
+#endif
+
+  if(!executed)
+    return;
+
+  if(retval != RET_PASS)
+    retDepRecord(level->test->tag, retval);
+#ifdef RET_VIRTUAL_CLOCK
+  retClockCancelOwner(level);
+#endif
+  level->child_time += net_time;
+  if(net_time > level->child_max)
+    level->child_max = net_time;
+#ifdef RET_COVERAGE
+  if(!ret_soak.is_active)
+    retCoverageLineFormat(ret.nest - 1);
+#endif
+
+  if(ret_soak.is_active) {
+    /* Soak - leaf statistics & failure reports only */
+    if(children == NULL) {
+      retSoakRecord(retval, elapsed_time, net_time);
+      if(retval != RET_PASS) {
+        retTestLineFormat(retval, elapsed_time, net_time);
+        RET_CLOCK_LINE(retval, level);
+      }
+    }
+  } else if(children != NULL) {
+    if(param->report == RET_REPORT_FULL)
+      retTestLineFormat(retval, elapsed_time, net_time);
+    else
+      retBranchLineFormat(retval, elapsed_time, net_time, children);
+    RET_CLOCK_LINE(retval, level);
+  } else if((param->report == RET_REPORT_FULL) || (retval != RET_PASS)) {
+    retTestLineFormat(retval, elapsed_time, net_time);
+    RET_CLOCK_LINE(retval, level);
+    if(ret_perf.count != 0)
+      retPerfLineFormat(retval, elapsed_time, net_time);
   }
 }
 
 
 /**************************************************************************//**
- * @brief Append a test tag to the tag path
- * @param char* - tag
+ * @brief Clear the rollup of the tests below the current test
+ * @param none
  * @return none
  */
-static ret_retval_t retAddTag(const char* const tag)
-{
-  char* save_previous;
-  static char tag_separator[] = {RET_TOKEN_DELIMITER, '\0'};
-
-  save_previous = ret.tag_ptr;
-  ret.tag_ptr += strlen(tag) + sizeof tag_separator - 1;
-
-  /* Check for tag buffer overrun */
-  if(!(ret.tag_ptr < ret.tag_str + RET_MAX_TAG_STRING_SIZE)) {
-    ret.tag_ptr = save_previous;
-    return RET_ERR_TAG;
+static void retClearRollup(void) {
+  if(ret.nest < RET_MAX_NEST_SIZE) {
+    ret_env[ret.nest].pass = 0;
+    ret_env[ret.nest].fail = 0;
+    ret_env[ret.nest].skip = 0;
+    ret_env[ret.nest].child_time = 0;
+    ret_env[ret.nest].child_max = 0;
+    ret_env[ret.nest].is_overlap = false;
   }
+}
 
-  /* Append test tag to the global tag path */
-  strcat(save_previous, tag_separator);
-  strcat(save_previous, tag);
 
-  /* Increment nesting level */
-  ret.nest++;
-  return RET_PASS;
+/**************************************************************************//**
+ * @brief Subtract the report output time since a nest level timer started
+ * @param uint32_t - elapsed time for test execution
+ * @param uint32_t - ret.io_time when the timer started
+ * @return uint32_t - elapsed time less report output time
+ */
+static uint32_t retNetTime(uint32_t elapsed_time, uint32_t io_mark) {
+  uint32_t io_time = ret.io_time - io_mark;
+
+  return (elapsed_time > io_time) ? elapsed_time - io_time : 0;
+}
+
+
+/**************************************************************************//**
+ * @brief Derive the order key of the entered list from the order seed
+ *
+ * The seed is mixed with the tag path of the list so that each list of the
+ * tree has its own order.
+ *
+ * @param none
+ * @return uint32_t - key of retOrderIndex
+ */
+static uint32_t retOrderKey(void) {
+  const char* tag;
+  uint32_t    hash = ret.order_seed;
+
+  /* FNV-1a of the tag path then a murmur3 finalizer */
+  for(tag = ret.tag_str; tag < ret.tag_ptr; tag++) {
+    hash ^= (uint8_t)*tag;
+    hash *= 16777619u;
+  }
+  hash ^= hash >> 16;
+  hash *= 0x85ebca6bu;
+  hash ^= hash >> 13;
+  hash *= 0xc2b2ae35u;
+  hash ^= hash >> 16;
+  return hash;
+}
+
+
+/**************************************************************************//**
+ * @brief Map a list position to the index of the test executed there
+ *
+ * A keyed four round Feistel network permutes the smallest 2^(2 * half)
+ * domain that holds the list, and an index beyond the list is walked along
+ * its cycle until one falls inside it.  This is a bijection on 0 to size - 1
+ * with no table for lists of any size, and any test may follow any other.
+ *
+ * @param uint32_t - key from retOrderKey
+ * @param uint32_t - number of tests in the list
+ * @param uint32_t - position in the execution order (< size)
+ * @return uint32_t - index of the test in the list
+ */
+static uint32_t retOrderIndex(uint32_t key, uint32_t size, uint32_t n) {
+  uint32_t    half = 1;
+  uint32_t    mask, left, right, round, mix;
+
+  while((half < 16) && ((1u << (2 * half)) < size))
+    half++;
+  mask = (half < 16) ? (1u << half) - 1 : 0xFFFFu;
+  do {
+    left = n >> half;
+    right = n & mask;
+    for(round = 0; round < 4; round++) {
+      /* Round function: murmur3 finalizer of the key, round and half */
+      mix = right ^ key ^ (round * 0x9e3779b9u);
+      mix ^= mix >> 16;
+      mix *= 0x85ebca6bu;
+      mix ^= mix >> 13;
+      mix *= 0xc2b2ae35u;
+      mix ^= mix >> 16;
+      mix = (left ^ mix) & mask;
+      left = right;
+      right = mix;
+    }
+    n = (left << half) | right;
+  } while(n >= size);
+  return n;
+}
+
+
+/**************************************************************************//**
+ * @brief Report the order seed of the run
+ * @param none
+ * @return none
+ */
+static void retOrderLine(void) {
+  char line_buf[24];
+  char ascii_buf[11];
+  char* digit = ascii_buf + sizeof ascii_buf - 1;
+  uint32_t seed = ret.order_seed;
+
+  /* Unsigned (retConvIntToDecAscii is signed) */
+  *digit = '\0';
+  do {
+    *--digit = (char)('0' + seed % 10);
+    seed /= 10;
+  } while(seed != 0);
+  strcpy(line_buf, RET_ORDER_MSG);
+  strcat(line_buf, digit);
+  retInfoLine(line_buf, RET_PAUSE);
+}
+
+
+/**************************************************************************//**
+ * @brief Set the cache state of an executed test before its timer starts
+ *
+ * RET_CACHE_COLD flushes the caches.  RET_CACHE_WARM executes the test once
+ * (a branch returns from retExecuteList at once) with the timer started, so
+ * a failure of the rehearsal is reported as the result of the test.  Its
+ * information lines, trace events and coverage are dropped (see
+ * retCacheEnd for its time).
+ *
+ * @param ret_param_t* - pointer to user control structure
+ * @param ret_test_t* - pointer to the entered test
+ * @return none
+ */
+static void retCachePrepare(ret_param_t* param, const ret_test_t* test) {
+  ret_env_t*  level = &ret_env[ret.nest - 1];
+
+  ret_cache.start = RET_SYS_TICK_FUNC();
+  ret_cache.io_time = ret.io_time;
+#ifdef RET_VIRTUAL_CLOCK
+  ret_cache.vnow = ret_clock.now;
+#endif
+  if(param->cache == RET_CACHE_COLD) {
+    if(ret_cache.is_ready)
+      ret_cache.port->flush();
+  } else {
+    level->timer = ret_cache.start;
+    level->io_mark = ret_cache.io_time;
+#ifdef RET_VIRTUAL_CLOCK
+    level->vtimer = ret_clock.now;
+#endif
+    param->async = &ret_async[ret.async_count].ctx;
+    memset(param->async, 0, sizeof *param->async);
+    ret_cache.is_rehearsal = true;
+    (void)test->func(param);
+  }
+  retCacheEnd();
+}
+
+
+/**************************************************************************//**
+ * @brief Take the time of a flush or rehearsal out of the run
+ *
+ * The time is added to ret.io_time so that it is excluded from the net time
+ * of the enclosing branches, and the timers of the waiting async leaves are
+ * moved on by it so that it does not count against their timeouts.  The
+ * virtual clock is set back to the start of a rehearsal.  Also called when a
+ * rehearsal fails (longjmp to retExecuteList).
+ *
+ * @param none
+ * @return none
+ */
+static void retCacheEnd(void) {
+  uint32_t    elapsed = RET_SYS_TICK_FUNC() - ret_cache.start;
+  uint32_t    n;
+
+  if(ret_cache.is_rehearsal) {
+    ret_cache.is_rehearsal = false;
+#ifdef RET_VIRTUAL_CLOCK
+    retClockCancelOwner(&ret_env[ret.nest - 1]);
+    ret_clock.now = ret_cache.vnow;
+#endif
+  }
+  for(n = 0; n < ret.async_count; n++) {
+    ret_async[n].timer += elapsed;
+    ret_async[n].io_mark += elapsed;
+  }
+  ret.io_time = ret_cache.io_time + elapsed;
+}
+
+
+/**************************************************************************//**
+ * @brief Find a failed prerequisite of a test
+ * @param ret_test_t* - pointer to the entered test (deps not NULL)
+ * @return char* - tag of the failed prerequisite (NULL = none failed)
+ */
+static const char* retDepFailed(const ret_test_t* test) {
+  const char* const* dep;
+  uint32_t    n;
+
+  for(dep = test->deps; *dep != NULL; dep++) {
+    for(n = 0; n < ret_dep.count; n++) {
+      if(strcmp(ret_dep.tags[n], *dep) == 0)
+        return ret_dep.tags[n];
+    }
+  }
+  return NULL;
+}
+
+
+/**************************************************************************//**
+ * @brief Add the tag of a failed (or blocked) test to the failed tags
+ *
+ * A blocked test is not the cause that a fail fast list reports.
+ *
+ * @param char* - test tag
+ * @param ret_retval_t - return value of the test (not RET_PASS)
+ * @return none
+ */
+static void retDepRecord(const char* tag, ret_retval_t retval) {
+  uint32_t n;
+
+  if(retval != RET_BLOCKED)
+    ret_dep.last = tag;
+  for(n = 0; n < ret_dep.count; n++) {
+    if(strcmp(ret_dep.tags[n], tag) == 0)
+      return;
+  }
+  if(ret_dep.count < RET_MAX_FAILED_TAGS)
+    ret_dep.tags[ret_dep.count++] = tag;
+}
+
+
+/**************************************************************************//**
+ * @brief Report the failed test that blocks the entered test
+ * @param char* - tag of the failed test
+ * @return none
+ */
+static void retDepLine(const char* tag) {
+  char line_buf[RET_MAX_TAG_STRING_SIZE + 16];
+
+  strcpy(line_buf, RET_BLOCKED_MSG);
+  strncat(line_buf, tag, RET_MAX_TAG_STRING_SIZE);
+  retInfoLineFmt(line_buf);
+}
+
+
+/**************************************************************************//**
+ * @brief Stop the counters of an async leaf poll & add the counts to a total
+ * @param uint32_t* - counts of the earlier polls
+ * @return none
+ */
+static void retPerfPause(uint32_t* total) {
+  uint32_t n;
+
+  ret_perf.port->stop(ret_perf.counts);
+  for(n = 0; n < ret_perf.count; n++)
+    total[n] += ret_perf.counts[n];
+}
+
+
+/**************************************************************************//**
+ * @brief Start timing report output (formatting & sending)
+ *
+ * Output functions call each other (ie: a line feed sends the buffer), so
+ * only the outermost call is timed.
+ *
+ * @param none
+ * @return none
+ */
+static void retIoBegin(void) {
+  if(ret.io_depth++ == 0)
+    ret.io_timer = RET_SYS_TICK_FUNC();
+}
+
+
+/**************************************************************************//**
+ * @brief Stop timing report output & add it to ret.io_time
+ * @param none
+ * @return none
+ */
+static void retIoEnd(void) {
+  if(--ret.io_depth == 0)
+    ret.io_time += RET_SYS_TICK_FUNC() - ret.io_timer;
+}
+
+
+/**************************************************************************//**
+ * @brief Park a waiting async leaf in the scheduler
+ *
+ * The async context was handed to the leaf by retEnter in the next free slot.
+ * Record the test and its start time, then remove its tag so that the list
+ * walk continues with the next test.
+ *
+ * @param ret_param_t* - pointer to user control structure
+ * @param ret_test_t* - pointer to the waiting test
+ * @return none
+ */
+static void retAsyncPark(ret_param_t* param, const ret_test_t* test) {
+  ret_async_slot_t* slot = &ret_async[ret.async_count++];
+
+  slot->test = test;
+  slot->case_index = param->case_index;
+  slot->timer = ret_env[ret.nest - 1].timer;
+  slot->io_mark = ret_env[ret.nest - 1].io_mark;
+  ret_env[ret.nest - 1].is_overlap = true;
+#ifdef RET_VIRTUAL_CLOCK
+  slot->vtimer = ret_env[ret.nest - 1].vtimer;
+  slot->is_virtual = (ret_clock.reads != ret_clock.poll_mark);
+#endif
+#ifdef RET_RESUME
+  slot->path_hash = retResumeHash(ret.tag_str,
+                                  (uint32_t)(ret.tag_ptr - ret.tag_str));
+#endif
+  if(ret_perf.count != 0) {
+    memset(slot->perf, 0, sizeof slot->perf);
+    retPerfPause(slot->perf);
+  }
+#ifdef RET_COVERAGE
+  retCoverageSave(slot);
+#endif
+  RET_TRACE_EVENT('E', test->tag, param->case_index);
+  retRemoveTag(ret.nest - 1);
+}
+
+
+/**************************************************************************//**
+ * @brief Resume waiting async leaves until few enough are left waiting
+ *
+ * Waiting leaves of the current list (slots from first_slot) are resumed in
+ * turn until no more than max_waiting slots are in use.  User control values
+ * changed for a resumed leaf are restored for the list walk.  With
+ * RET_VIRTUAL_CLOCK a pass in which no leaf completed advances virtual time
+ * by one tick, unless a leaf of the list waits on something other than the
+ * virtual clock (its last poll did not read it).  Real time then has to pass
+ * for that leaf, so virtual time stands still until it completes.
+ *
+ * @param ret_param_t* - pointer to user control structure
+ * @param uint32_t - first slot of the current list
+ * @param uint32_t - number of slots that may remain in use
+ * @return ret_retval_t - RET_FAIL if any completed leaf failed
+ */
+static ret_retval_t retAsyncSchedule(ret_param_t* param, uint32_t first_slot,
+                                     uint32_t max_waiting) {
+  ret_mode_t  save_mode = param->mode;
+  uint32_t    save_case_index = param->case_index;
+  uint32_t    slot;
+  ret_retval_t err_flag = RET_PASS;
+#ifdef RET_VIRTUAL_CLOCK
+  uint32_t    waiting;
+  bool        is_virtual;
+#endif
+
+  while(ret.async_count > max_waiting) {
+#ifdef RET_VIRTUAL_CLOCK
+    waiting = ret.async_count;
+    is_virtual = true;
+#endif
+    for(slot = first_slot; slot < ret.async_count; ) {
+      switch(retAsyncResume(param, slot)) {
+        case RET_PENDING:
+#ifdef RET_VIRTUAL_CLOCK
+          if(!ret_async[slot].is_virtual)
+            is_virtual = false;
+#endif
+          slot++;
+          break;
+
+        case RET_PASS:
+          break;
+
+        default:
+          err_flag = RET_FAIL;
+          break;
+      }
+    }
+#ifdef RET_VIRTUAL_CLOCK
+    if((ret.async_count == waiting) && is_virtual)
+      retClockAdvance(ret_clock.now + 1);
+#endif
+  }
+
+  param->mode = save_mode;
+  param->case_index = save_case_index;
+  return err_flag;
+}
+
+
+/**************************************************************************//**
+ * @brief Resume a waiting async leaf
+ *
+ * The test tag is restored to the tag path for the leaf and its report.  A
+ * completed (or timed out) leaf is reported and its slot released.
+ *
+ * @param ret_param_t* - pointer to user control structure
+ * @param uint32_t - scheduler slot of the waiting leaf
+ * @return ret_retval_t - RET_PENDING if the leaf is still waiting
+ */
+static ret_retval_t retAsyncResume(ret_param_t* param, uint32_t slot) {
+  ret_async_slot_t* waiting = &ret_async[slot];
+  const ret_test_t* test = waiting->test;
+  char        case_str[RET_CASE_STR_SIZE];
+  ret_retval_t retval;
+  int         longjmp_val;
+
+  param->mode = RET_MODE_EXE;
+  param->case_index = waiting->case_index;
+  param->async = &waiting->ctx;
+  case_str[0] = '\0';
+  param->test_case = NULL;
+  if(test->cases != NULL) {
+    retCaseSuffix(case_str, param, test);
+    param->test_case = (const uint8_t*)test->cases->table +
+                       param->case_index * test->cases->size;
+  }
+  /* Tag length was checked when the leaf was entered */
+  retAddTag(test, case_str);
+  ret_env[ret.nest - 1].test = test;
+  ret_env[ret.nest - 1].case_index = waiting->case_index;
+  retClearRollup();
+#ifdef RET_COVERAGE
+  retCoverageRestore(waiting);
+#endif
+
+#ifdef RET_VIRTUAL_CLOCK
+  /* A leaf waiting on something other than the virtual clock times out in
+   * real time, since virtual time does not pass while it waits */
+  if((waiting->ctx.timeout != 0) &&
+     ((waiting->is_virtual ? ret_clock.now - waiting->vtimer :
+       RET_SYS_TICK_FUNC() - waiting->timer) >= waiting->ctx.timeout)) {
+#else
+  if((waiting->ctx.timeout != 0) &&
+     (RET_SYS_TICK_FUNC() - waiting->timer >= waiting->ctx.timeout)) {
+#endif
+    retval = RET_ERR_TIMEOUT;
+    /* No poll - the counts are those of the earlier polls */
+    if(ret_perf.count != 0)
+      ret_perf.port->start();
+  } else if((longjmp_val = RET_SETJMP(ret_env[ret.nest - 1].env)) == 0) {
+    RET_TRACE_EVENT('B', test->tag, param->case_index);
+#ifdef RET_RESUME
+    retResumeRecord(false);
+#endif
+    if(ret_perf.count != 0)
+      ret_perf.port->start();
+#ifdef RET_VIRTUAL_CLOCK
+    ret_clock.poll_mark = ret_clock.reads;
+#endif
+    retval = test->func(param);
+  } else {
+    /* longjmp from retAssert() (or retSignalHandler() with -2) */
+    retval = RET_FAIL;
+#ifdef RET_SIGNAL
+    if(longjmp_val == -2)
+      retval = retSignalFault();
+#else
+    (void)longjmp_val;
+#endif
+  }
+
+  if(retval == RET_PENDING) {
+#ifdef RET_TRACE
+    /* Drop the begin event of a poll that is still waiting */
+    if((ret_trace.count != 0) &&
+       (ret_trace.events[ret_trace.count - 1].name == test->tag))
+      ret_trace.count--;
+    else
+      retTraceEvent('E', test->tag, param->case_index);
+#endif
+    if(ret_perf.count != 0)
+      retPerfPause(waiting->perf);
+#ifdef RET_VIRTUAL_CLOCK
+    waiting->is_virtual = (ret_clock.reads != ret_clock.poll_mark);
+#endif
+#ifdef RET_COVERAGE
+    retCoverageSave(waiting);
+#endif
+    retRemoveTag(ret.nest - 1);
+    return retval;
+  }
+
+  /* Release the slot before the report (retExit may longjmp to the root) */
+  ret_env[ret.nest - 1].timer = waiting->timer;
+  ret_env[ret.nest - 1].io_mark = waiting->io_mark;
+#ifdef RET_VIRTUAL_CLOCK
+  ret_env[ret.nest - 1].vtimer = waiting->vtimer;
+#endif
+  memcpy(ret_perf.carry, waiting->perf, sizeof ret_perf.carry);
+  memmove(waiting, waiting + 1,
+          (--ret.async_count - slot) * sizeof *waiting);
+  retExit(param, retval);
+  return retval;
+}
+
+
+/**************************************************************************//**
+ * @brief Determine if the test tag is contained exactly in the constructed tag
+ *
+ * Remove the last test tag from the executed test.  Jump to the root level
+ * (test completed) if the param.tag is the last segment of ret.tag_str.  When
+ * the root level calls this function the result buffer is sent to the host.
+ *
+ * @param ret_param_t* - pointer to user control structure
+ * @return ret_retval_t - see ret.h
+ */
+static bool retFindTagToken(ret_param_t *param) {
+  char* tag_pos;
+  char* tag_end;
+  const char* case_pos;
+  uint32_t case_index, case_last;
+
+  /* Check if the test string is a ret.tag_str token
+   * Check character beyond end of test string since it may be a subset
+   * of a larger tag (ie: ...@testXXX@... and ...@testXXXConfig@...)
+   * A case suffix also terminates a token (ie: ...@testXXX[17]...)
+   */
+  for(tag_pos = strchr(ret.tag_str, *param->test_tag); tag_pos != NULL;
+      tag_pos = strchr(tag_pos + 1, *param->test_tag)) {
+    if(strncmp(tag_pos, param->test_tag, ret.sel_len) != 0)
+      continue;
+
+    tag_end = tag_pos + ret.sel_len;
+    if(!ret.sel_range) {
+      if((*tag_end == RET_TOKEN_DELIMITER) || (*tag_end == RET_CASE_OPEN) ||
+         (*tag_end == '\0'))
+        break;
+    } else if(*tag_end == RET_CASE_OPEN) {
+      /* Range selection - case index of the token must be inside range (a
+       * search token lists the case range of the leaf, ie: [0-199])
+       */
+      case_pos = tag_end + 1;
+      if(!retParseDecimal(&case_pos, &case_index))
+        continue;
+      case_last = case_index;
+      if(*case_pos == RET_CASE_RANGE) {
+        case_pos++;
+        if(!retParseDecimal(&case_pos, &case_last))
+          continue;
+      }
+      if((*case_pos == RET_CASE_CLOSE) &&
+         (case_last >= ret.sel_first) && (case_index <= ret.sel_last))
+        break;
+    }
+  }
+
+  if(tag_pos == NULL) {
+    return false;
+  } else {
+    /* Increment flag to indicate path tag_found */
+    param->tag_found++;
+    return true;
+  }
+}
+
+
+/**************************************************************************//**
+ * @brief Split the user test string into a tag and an optional case range
+ *
+ * A test string of the form tag[n] or tag[first-last] selects cases of a
+ * parameterized leaf.  Any other test string is compared as a whole.
+ *
+ * @param char* - user test string
+ * @return none
+ */
+static void retParseSelector(const char* test_tag) {
+  const char* case_pos;
+
+  ret.sel_len = strlen(test_tag);
+  ret.sel_range = false;
+
+  case_pos = strchr(test_tag, RET_CASE_OPEN);
+  if(case_pos == NULL)
+    return;
+
+  case_pos++;
+  ret.sel_range = retParseDecimal(&case_pos, &ret.sel_first);
+  ret.sel_last = ret.sel_first;
+  if(ret.sel_range && (*case_pos == RET_CASE_RANGE)) {
+    case_pos++;
+    ret.sel_range = retParseDecimal(&case_pos, &ret.sel_last);
+  }
+  if(ret.sel_range && (*case_pos == RET_CASE_CLOSE) &&
+     (*(case_pos + 1) == '\0')) {
+    ret.sel_len = strchr(test_tag, RET_CASE_OPEN) - test_tag;
+  } else {
+    /* Malformed range - compare the test string as a whole */
+    ret.sel_range = false;
+  }
+}
+
+
+/**************************************************************************//**
+ * @brief Convert unsigned decimal ascii to binary
+ * @param char** - string pointer (advanced past the digits)
+ * @param uint32_t* - binary output value
+ * @return bool - true if at least one digit was converted
+ */
+static bool retParseDecimal(const char** str, uint32_t* value) {
+  const char* start = *str;
+
+  for(*value = 0; (**str >= '0') && (**str <= '9'); (*str)++)
+    *value = *value * 10 + (uint32_t)(**str - '0');
+
+  return(*str != start);
+}
+
+
+/**************************************************************************//**
+ * @brief Build the case suffix of a parameterized test tag
+ *
+ * Executed cases are suffixed with their index (ie: [17]) and a search lists
+ * the range of available cases (ie: [0-199]).  An empty case table has an
+ * empty suffix ([]).
+ *
+ * @param char* - destination buffer (minimum size = RET_CASE_STR_SIZE)
+ * @param ret_param_t* - pointer to user control structure
+ * @param ret_test_t* - pointer to test structure (func + tag + cases)
+ * @return none
+ */
+static void retCaseSuffix(char* dst_buf, ret_param_t* param,
+                          const ret_test_t* test)
+{
+  char* ch_ptr = dst_buf;
+
+  *ch_ptr++ = RET_CASE_OPEN;
+  if(test->cases->count == 0) {
+    *ch_ptr = '\0';
+  } else if(param->mode != RET_MODE_SEARCH) {
+    retConvIntToDecAscii(ch_ptr, (int32_t)param->case_index);
+  } else {
+    retConvIntToDecAscii(ch_ptr, 0);
+    ch_ptr += strlen(ch_ptr);
+    *ch_ptr++ = RET_CASE_RANGE;
+    retConvIntToDecAscii(ch_ptr, (int32_t)(test->cases->count - 1));
+  }
+  ch_ptr += strlen(ch_ptr);
+  *ch_ptr++ = RET_CASE_CLOSE;
+  *ch_ptr = '\0';
+}
+
+
+/**************************************************************************//**
+ * @brief Append a test tag to the tag path
+ * @param ret_test_t* - test (tag_len is used when set)
+ * @param char* - tag suffix (ie: case index of a parameterized test)
+ * @return ret_retval_t - RET_ERR_TAG if the tag path would overflow
+ */
+static ret_retval_t retAddTag(const ret_test_t* test, const char* const suffix)
+{
+  size_t tag_len = test->tag_len ? test->tag_len : strlen(test->tag);
+  size_t suffix_len = strlen(suffix);
+
+  /* Check for tag buffer overrun (delimiter, tag, suffix & terminator) */
+  if((size_t)(ret.tag_ptr - ret.tag_str) + 1 + tag_len + suffix_len >=
+     RET_MAX_TAG_STRING_SIZE)
+    return RET_ERR_TAG;
+
+  /* Append test tag to the global tag path */
+  *ret.tag_ptr++ = RET_TOKEN_DELIMITER;
+  memcpy(ret.tag_ptr, test->tag, tag_len);
+  ret.tag_ptr += tag_len;
+  memcpy(ret.tag_ptr, suffix, suffix_len + 1);
+  ret.tag_ptr += suffix_len;
+
+  /* Increment nesting level */
+  ret.nest++;
+  return RET_PASS;
 }
 
 
@@ -394,279 +1849,1298 @@ static void retRemoveTag(uint32_t nest_val) {
 
 
 /**************************************************************************//**
- * @brief Diagnostic routine called by RET_ASSERT macro
- *
- * This function returns immediately if assert_condition is non-zero (ie: true)
- * A zero assert_condition constitutes a function failure which causes an
- * information line to be generated for the final report as well as terminating
- * the execution of the test function via a longjmp to retEnter.
- *
- * @param int - statement for TRUE/FALSE evaluation
- * @param ret_param_t* - pointer to user control structure
- * @param int - __LINE__ macro from calling file
- * @param int - __FILE__ macro from calling file
+ * @brief Diagnostic routine called by RET_ASSERT macro
+ *
+ * This function returns immediately if assert_condition is non-zero (ie: true)
+ * A zero assert_condition constitutes a function failure which causes an
+ * information line to be generated for the final report as well as terminating
+ * the execution of the test function via a longjmp to retEnter.
+ *
+ * @param int - statement for TRUE/FALSE evaluation
+ * @param ret_param_t* - pointer to user control structure
+ * @param int - __LINE__ macro from calling file
+ * @param int - __FILE__ macro from calling file
+ * @return none
+ */
+void retAssert(int assert_condition, ret_param_t *param, int line_number,
+               const char *file_name) {
+
+  if(assert_condition) {
+    return;
+  } else {
+    char assert_buf[128];
+
+    retIoBegin();
+#ifndef RET_NO_PRINTF
+    sprintf(assert_buf, "Assert at line %d of %s == %d", line_number, file_name,
+            param->retval);
+#else
+    char ascii_buf[12];
+
+    assert_buf[0] = '\0';
+    strcat(assert_buf, "Assert at line ");
+    retConvIntToDecAscii(ascii_buf, line_number);
+    strcat(assert_buf, ascii_buf);
+    strcat(assert_buf, " of ");
+    strcat(assert_buf, file_name);
+    strcat(assert_buf, " == ");
+    retConvIntToDecAscii(ascii_buf, param->retval);
+    strcat(assert_buf, ascii_buf);
+#endif
+    RET_TRACE_EVENT('I', file_name, line_number);
+#ifdef RET_FAIL_LOG
+    /* Report the held lines of the test ahead of the assert (never held) */
+    retLogRelease(&ret_env[ret.nest - 1], true);
+#endif
+    retFormatLine('I', assert_buf, RET_NO_PAUSE);
+    retIoEnd();
+    RET_LONGJMP(ret_env[ret.nest - 1].env, -1);
+  }
+}
+
+
+/**************************************************************************//**
+ * @brief Append information line to output buffer
+ *
+ * Construct information line and pass to output buffer for display at the
+ * conclusion of the test.
+ *
+ * @param char* - message to append to output report buffer
+ * @return none
+ */
+void retInfoLineFmt(const char* str)
+{
+  retInfoLine(str, RET_NO_PAUSE);
+}
+
+
+/**************************************************************************//**
+ * @brief Append information line to output buffer with pause option
+ * @param char* - message to append to output report buffer
+ * @param bool - 1|0 : send msg immediately|send msg at completion of test
+ * @return none
+ */
+void retInfoLine(const char* str, bool pause)
+{
+  /* A rehearsal (RET_CACHE_WARM) is not reported */
+  if(ret_cache.is_rehearsal)
+    return;
+#ifdef RET_FAIL_LOG
+  /* Hold the lines of a running test until it completes */
+  if((pause == RET_NO_PAUSE) && (ret.nest != 0) && ret_log.is_active) {
+    retLogAppend(str);
+    return;
+  }
+#endif
+  retFormatLine('I', str, pause);
+}
+
+
+/**************************************************************************//**
+ * @brief Set the performance counter port used for leaf reports
+ *
+ * The port is opened at the start of each run.  If no counters are available
+ * an information line is reported and the run continues without counters.
+ *
+ * @param ret_perf_port_t* - counter port (NULL to disable counters)
+ * @return none
+ */
+void retSetPerfPort(const ret_perf_port_t* port)
+{
+  ret_perf.port = port;
+}
+
+
+/**************************************************************************//**
+ * @brief Set the cache flush port used by RET_CACHE_COLD runs
+ *
+ * The port is opened at the start of each RET_CACHE_COLD run.  If the flush
+ * is not available an information line is reported and the run continues
+ * without flushing.
+ *
+ * @param ret_cache_port_t* - flush port (NULL to disable flushing)
+ * @return none
+ */
+void retSetCachePort(const ret_cache_port_t* port)
+{
+  ret_cache.port = port;
+}
+
+
+/**************************************************************************//**
+ * @brief Send search line to communication port immediately
+ * @param char* - message to append to output report buffer
+ * @return none
+ */
+static void retSearchLine(const char* str)
+{
+  retFormatLine('S', str, RET_NO_PAUSE);
+}
+
+
+/**************************************************************************//**
+ * @brief Send msg to output buffer or to comm port immediately
+ * @param char - message type character
+ * @param char* - message to append to output report buffer
+ * @param bool - 1|0 : send msg immediately|send msg at completion of test
+ * @return none
+ */
+static void retFormatLine(char msg_type, const char* str, bool pause)
+{
+  bool save_pause;
+
+  retIoBegin();
+  save_pause = ret_buf.is_pause;
+  ret_buf.is_pause = pause;
+  retPutChar(msg_type);
+  retPutCommaSeparator();
+  retDecimalDigits(ret.next_line_number++ , 4);
+  retPutCommaSeparator();
+  retPutString("    ");
+  retPutCommaSeparator();
+  retPutString("      ");
+  retPutCommaSeparator();
+  retPutString("      ");
+  retPutCommaSeparator();
+  if(strlen(str) > RET_MAX_TAG_STRING_SIZE) {
+    str = "<string exceeds length limit>";
+  }
+  retPutString(str);
+  retPutLineFeed();
+  ret_buf.is_pause = save_pause;
+  retIoEnd();
+}
+
+
+/**************************************************************************//**
+ * @brief Send test result to output buffer
+ * @param ret_retval_t - return value of test
+ * @param uint32_t - elapsed time for test execution
+ * @param uint32_t - elapsed time less report output time
+ * @return none
+ */
+static void retTestLineFormat(ret_retval_t retval, uint32_t elapsed_time,
+                              uint32_t net_time) {
+  retIoBegin();
+  retPutChar('T');
+  retPutCommaSeparator();
+  retDecimalDigits(ret.next_line_number++ , 4) ;
+  retPutCommaSeparator();
+  retPutString(RET_RETVAL_STR[retval]);
+  retPutCommaSeparator();
+  retDecimalDigits(elapsed_time , 6);
+  retPutCommaSeparator();
+  retDecimalDigits(net_time , 6);
+  retPutCommaSeparator();
+  retPutString(ret.tag_str);
+  retPutLineFeed();
+  retIoEnd();
+}
+
+/**************************************************************************//**
+ * @brief Send performance counts of the last test to output buffer
+ * @param ret_retval_t - return value of test
+ * @param uint32_t - elapsed time for test execution
+ * @param uint32_t - elapsed time less report output time
+ * @return none
+ */
+static void retPerfLineFormat(ret_retval_t retval, uint32_t elapsed_time,
+                              uint32_t net_time) {
+  uint32_t n;
+
+  retIoBegin();
+  retPutChar('P');
+  retPutCommaSeparator();
+  retDecimalDigits(ret.next_line_number++ , 4) ;
+  retPutCommaSeparator();
+  retPutString(RET_RETVAL_STR[retval]);
+  retPutCommaSeparator();
+  retDecimalDigits(elapsed_time , 6);
+  retPutCommaSeparator();
+  retDecimalDigits(net_time , 6);
+  retPutCommaSeparator();
+  retPutString(ret.tag_str);
+  for(n = 0; n < ret_perf.count; n++) {
+    retPutCommaSeparator();
+    retPutString(ret_perf.port->names[n]);
+    retPutChar('=');
+    retPutDecimal(ret_perf.counts[n]);
+  }
+  retPutLineFeed();
+  retIoEnd();
+}
+
+
+/**************************************************************************//**
+ * @brief Send branch aggregate to output buffer
+ * @param ret_retval_t - return value of test
+ * @param uint32_t - elapsed time for test execution
+ * @param uint32_t - elapsed time less report output time
+ * @param ret_env_t* - rollup of the tests executed by the branch
+ * @return none
+ */
+static void retBranchLineFormat(ret_retval_t retval, uint32_t elapsed_time,
+                                uint32_t net_time, ret_env_t* children) {
+  retIoBegin();
+  retPutChar('B');
+  retPutCommaSeparator();
+  retDecimalDigits(ret.next_line_number++ , 4) ;
+  retPutCommaSeparator();
+  retPutString(RET_RETVAL_STR[retval]);
+  retPutCommaSeparator();
+  retDecimalDigits(elapsed_time , 6);
+  retPutCommaSeparator();
+  retDecimalDigits(net_time , 6);
+  retPutCommaSeparator();
+  retPutString(ret.tag_str);
+  retPutCommaSeparator();
+  retDecimalDigits(children->pass, 6);
+  retPutCommaSeparator();
+  retDecimalDigits(children->fail, 6);
+  retPutCommaSeparator();
+  retDecimalDigits(children->skip, 6);
+  retPutCommaSeparator();
+  retDecimalDigits(children->child_time, 6);
+  retPutCommaSeparator();
+  retDecimalDigits(children->child_max, 6);
+  retPutCommaSeparator();
+  /* Overlapping async children - the child time is not spent in sequence */
+  if(children->is_overlap)
+    retPutString("      ");
+  else
+    retDecimalDigits((net_time > children->child_time) ?
+                     net_time - children->child_time : 0, 6);
+  retPutLineFeed();
+  retIoEnd();
+}
+
+
+/**************************************************************************//**
+ * @brief Send run summary to output buffer
+ * @param ret_param_t* - pointer to user control structure
+ * @return none
+ */
+static void retSummaryLineFormat(ret_param_t* param) {
+  uint32_t elapsed_time = RET_SYS_TICK_FUNC() - ret.timer;
+
+  retIoBegin();
+  retPutChar('R');
+  retPutCommaSeparator();
+  retDecimalDigits(ret.next_line_number++ , 4) ;
+  retPutCommaSeparator();
+  retPutString(RET_RETVAL_STR[ret.fail ? RET_FAIL : RET_PASS]);
+  retPutCommaSeparator();
+  retDecimalDigits(elapsed_time, 6);
+  retPutCommaSeparator();
+  retDecimalDigits(retNetTime(elapsed_time, 0), 6);
+  retPutCommaSeparator();
+  retPutString(param->test_tag);
+  retPutCommaSeparator();
+  retDecimalDigits(ret.pass, 6);
+  retPutCommaSeparator();
+  retDecimalDigits(ret.fail, 6);
+  retPutCommaSeparator();
+  retDecimalDigits(ret.skip, 6);
+  retPutLineFeed();
+  retIoEnd();
+}
+
+/**************************************************************************//**
+ * @brief Send soak progress to output buffer
+ * @param ret_param_t* - pointer to user control structure
+ * @return none
+ */
+static void retSoakLineFormat(ret_param_t* param) {
+  bool save_pause = ret_buf.is_pause;
+  uint32_t elapsed_time = RET_SYS_TICK_FUNC() - ret.timer;
+
+  retIoBegin();
+  ret_buf.is_pause = RET_PAUSE;
+  retPutChar('K');
+  retPutCommaSeparator();
+  retDecimalDigits(ret.next_line_number++ , 4) ;
+  retPutCommaSeparator();
+  retPutString(RET_RETVAL_STR[ret.fail ? RET_FAIL : RET_PASS]);
+  retPutCommaSeparator();
+  retDecimalDigits(elapsed_time, 10);
+  retPutCommaSeparator();
+  retDecimalDigits(retNetTime(elapsed_time, 0), 10);
+  retPutCommaSeparator();
+  retPutString(param->test_tag);
+  retPutCommaSeparator();
+  retDecimalDigits(ret_soak.iteration, 10);
+  retPutCommaSeparator();
+  retDecimalDigits(ret.pass, 10);
+  retPutCommaSeparator();
+  retDecimalDigits(ret.fail, 10);
+  retPutCommaSeparator();
+  retDecimalDigits(ret_soak.untracked, 10);
+  retPutLineFeed();
+  ret_buf.is_pause = save_pause;
+  retIoEnd();
+}
+
+
+/**************************************************************************//**
+ * @brief Send soak statistics of a leaf to output buffer
+ * @param ret_soak_stat_t* - leaf statistics
+ * @return none
+ */
+static void retSoakStatLineFormat(ret_soak_stat_t* stat) {
+  uint32_t bucket;
+
+  retIoBegin();
+  retPutChar('H');
+  retPutCommaSeparator();
+  retDecimalDigits(ret.next_line_number++ , 4) ;
+  retPutCommaSeparator();
+  retPutString(RET_RETVAL_STR[stat->fail ? RET_FAIL : RET_PASS]);
+  retPutCommaSeparator();
+  retDecimalDigits(stat->max_time, 6);
+  retPutCommaSeparator();
+  retDecimalDigits(stat->max_net, 6);
+  retPutCommaSeparator();
+  retPutString(stat->tag);
+  retPutCommaSeparator();
+  retDecimalDigits(stat->pass, 10);
+  retPutCommaSeparator();
+  retDecimalDigits(stat->fail, 10);
+  retPutCommaSeparator();
+  retDecimalDigits(stat->first_fail, 10);
+  for(bucket = 0; bucket < RET_SOAK_HIST_SIZE; bucket++) {
+    retPutCommaSeparator();
+    retDecimalDigits(stat->hist[bucket], 10);
+  }
+  retPutLineFeed();
+  retIoEnd();
+}
+
+/* Helper routine to reverse the order of string characters */
+static void str_rev(char *start, char *end) {
+  char temp;
+  while(end > start) {
+    temp = *end;
+    *end-- = *start;
+    *start++ = temp;
+  }
+}
+
+
+/**************************************************************************//**
+ * @brief Convert signed long binary to signed decimal ascii
+ * @param char* - pointer to destination buffer (minimum size = 12)
+ * @param int32_t - binary signed input value
+ * @return none
+ */
+void retConvIntToDecAscii(char* dst_buf, int32_t val) {
+  char  *tmp_str = dst_buf;
+  bool    neg_flag = false;
+
+  /* Sign logic */
+  if(val < 0) {
+    /* Make input binary value positive */
+    val = -val;
+    neg_flag = true;
+  }
+
+  /* Characters are reversed by conversion */
+  do {
+    *tmp_str++ = (char)RET_DIGITS[val % 10];
+  } while(val /= 10);
+
+  /* Add negative sign character if required */
+  if(neg_flag) {
+    *tmp_str++ = '-';
+  }
+
+  /* Add zero terminator to temp string */
+  *tmp_str = '\0';
+
+  /* Reverse characters in temp string (exclude terminator) */
+  str_rev(dst_buf, tmp_str - 1);
+}
+
+
+/**************************************************************************//**
+ * @brief Convert unsigned long binary to unsigned decimal ascii & right justify
+ * into array of 'width' space characters for a vertically aligned output
+ * @param uint32_t - binary unsigned input value
+ * @param uint32_t - Length of text area in which to right justify char output
+ * @return none
+ */
+static void retDecimalDigits(uint32_t value, uint32_t width) {
+    static const char blanks[] = "           ";
+  static char work[sizeof blanks];
+  uint32_t next;
+  char* ch_ptr;
+
+  if((width > 0) && (width < sizeof work - 1)) {
+    strcpy(work, blanks);
+    ch_ptr = work + width;
+    *ch_ptr = '\0';
+    do {
+      next = value / 10 ;
+      *-- ch_ptr = (char)('0' + value - next * 10);
+      value = next ;
+    } while(value && ch_ptr > work);
+
+    retPutString(work);
+  }
+}
+
+
+/**************************************************************************//**
+ * @brief Convert unsigned long binary to unsigned decimal ascii (no padding)
+ * @param uint32_t - binary unsigned input value
+ * @return none
+ */
+static void retPutDecimal(uint32_t value) {
+  uint32_t width, next;
+
+  for(width = 1, next = value; next >= 10; next /= 10)
+    width++;
+  retDecimalDigits(value, width);
+}
+
+
+/**************************************************************************//**
+ * @brief Output char to the output buffer
+ *
+ * retPutChar should buffer characters until it sees a linefeed.
+ * On receipt of linefeed retPutChar may may do a synchronous output
+ * through a comm channel depending on ret_buf.is_pause
+ *
+ * @param char - character
+ * @return none
+ */
+static void retPutChar(const char c)
+{
+  /* Last byte is reserved for the terminator added by retSendBuffer */
+  if(ret_buf.next_in < ret_buf.buf + RET_REPORT_BUF_SIZE - 1) {
+    *ret_buf.next_in++ = c;
+    if('\n' == c && ret_buf.is_pause)
+      retSendBuffer();
+  }
+}
+
+
+/**************************************************************************//**
+ * @brief Output string to the output buffer
+ * @param char* - string
+ * @return none
+ */
+static void retPutString(const char* str)
+{
+  for(char c = *str++; c; c = *str++)
+    retPutChar(c);
+}
+
+
+/**************************************************************************//**
+ * @brief Output line feed to the output buffer
+ * @param none
+ * @return none
+ */
+static void retPutLineFeed(void) {
+#if 1
+  retPutChar ('\r');
+#endif
+  retPutChar('\n');
+}
+
+
+/**************************************************************************//**
+ * @brief Output field separator feed to the output buffer
+ * @param none
+ * @return none
+ */
+static void retPutCommaSeparator(void) {
+  retPutChar(',');
+}
+
+
+/**************************************************************************//**
+ * @brief Send output buffer to the communication channel
+ * @param none
+ * @return none
+ */
+static void retSendBuffer(void) {
+  if(ret_buf.next_in != ret_buf.buf) {
+    retIoBegin();
+#ifdef RET_TRACE
+    if(!ret_trace.is_sending)
+      retTraceEvent('B', RET_TRACE_FLUSH_MSG, 0);
+#endif
+    *ret_buf.next_in++ = '\0';
+    RET_SEND_BUF(ret_buf.buf)
+    ret_buf.next_in = ret_buf.buf;
+#ifdef RET_TRACE
+    if(!ret_trace.is_sending)
+      retTraceEvent('E', RET_TRACE_FLUSH_MSG, 0);
+#endif
+    retIoEnd();
+  }
+}
+
+
+#ifdef RET_TRACE
+/**************************************************************************//**
+ * @brief Capture an execution trace event (see RET_TRACE in ret.h)
+ * @param char - 'B'egin, 'E'nd or 'I'nstant
+ * @param char* - event name (string constant)
+ * @param uint32_t - event argument (ie: case index or line number)
+ * @return none
+ */
+void retTraceEvent(char event, const char* name, uint32_t arg) {
+  ret_trace_event_t* trace;
+
+  if(ret_cache.is_rehearsal)
+    return;
+  if(ret_trace.count >= RET_TRACE_BUF_SIZE) {
+    ret_trace.dropped++;
+    return;
+  }
+
+  trace = &ret_trace.events[ret_trace.count++];
+  trace->time = RET_TRACE_TICK_FUNC();
+  trace->name = name;
+  trace->arg = arg;
+  trace->event = event;
+  trace->nest = (uint8_t)ret.nest;
+}
+
+
+/**************************************************************************//**
+ * @brief Send the execution trace as X lines (header line first)
+ * @param none
+ * @return none
+ */
+static void retTraceSend(void) {
+  ret_trace_event_t header;
+  bool save_pause = ret_buf.is_pause;
+  uint32_t n;
+
+  header.time = RET_TRACE_TICK_HZ;
+  header.name = RET_TRACE_NAME_MSG;
+  header.arg = ret_trace.dropped;
+  header.event = 'H';
+  header.nest = 0;
+  ret_trace.is_sending = true;
+  ret_buf.is_pause = RET_PAUSE;
+
+  retTraceLineFormat(&header);
+  for(n = 0; n < ret_trace.count; n++)
+    retTraceLineFormat(&ret_trace.events[n]);
+
+  ret_buf.is_pause = save_pause;
+  ret_trace.is_sending = false;
+}
+
+
+/**************************************************************************//**
+ * @brief Send trace event to output buffer
+ * @param ret_trace_event_t* - trace event
+ * @return none
+ */
+static void retTraceLineFormat(ret_trace_event_t* trace) {
+  retPutChar('X');
+  retPutCommaSeparator();
+  retDecimalDigits(ret.next_line_number++ , 4);
+  retPutCommaSeparator();
+  retPutChar(trace->event);
+  retPutCommaSeparator();
+  retDecimalDigits(trace->time, 10);
+  retPutCommaSeparator();
+  retDecimalDigits(trace->nest, 2);
+  retPutCommaSeparator();
+  retDecimalDigits(trace->arg, 10);
+  retPutCommaSeparator();
+  retPutString(trace->name);
+  retPutLineFeed();
+}
+#endif
+
+
+#ifdef RET_COVERAGE
+/**************************************************************************//**
+ * @brief Record an instrumented function called by the executing test
+ *
+ * Called on entry to every function compiled with -finstrument-functions.
+ *
+ * @param void* - address of the called function
+ * @param void* - call site (not used)
+ * @return none
+ */
+void __cyg_profile_func_enter(void* func, void* call_site) {
+  uint32_t level, n;
+
+  /* Calls made by the report output (ie: retHostSend) or a rehearsal
+   * (RET_CACHE_WARM) are not recorded */
+  (void)call_site;
+  if((ret.nest == 0) || (ret.io_depth != 0) || ret_cache.is_rehearsal)
+    return;
+
+  level = ret.nest - 1;
+  for(n = 0; n < ret_cov.count[level]; n++) {
+    if(ret_cov.funcs[level][n] == func)
+      return;
+  }
+  if(n == RET_COVERAGE_MAX_FUNCS)
+    ret_cov.is_full[level] = true;
+  else
+    ret_cov.funcs[level][ret_cov.count[level]++] = func;
+}
+
+
+/**************************************************************************//**
+ * @brief Function exit hook of -finstrument-functions (not used)
+ * @param void* - address of the function
+ * @param void* - call site
+ * @return none
+ */
+void __cyg_profile_func_exit(void* func, void* call_site) {
+  (void)func;
+  (void)call_site;
+}
+
+
+/**************************************************************************//**
+ * @brief Keep the functions called by a waiting async leaf in its slot
+ *
+ * The tests run while the leaf waits record their calls at the same nest
+ * level, so the calls of each poll are moved to the slot.
+ *
+ * @param ret_async_slot_t* - slot of the leaf at the current nest level
+ * @return none
+ */
+static void retCoverageSave(ret_async_slot_t* slot) {
+  uint32_t level = ret.nest - 1;
+
+  slot->cov_count = ret_cov.count[level];
+  slot->cov_full = ret_cov.is_full[level];
+  memcpy(slot->cov_funcs, ret_cov.funcs[level],
+         slot->cov_count * sizeof *slot->cov_funcs);
+}
+
+
+/**************************************************************************//**
+ * @brief Restore the functions called by the earlier polls of an async leaf
+ * @param ret_async_slot_t* - slot of the leaf at the current nest level
+ * @return none
+ */
+static void retCoverageRestore(const ret_async_slot_t* slot) {
+  uint32_t level = ret.nest - 1;
+
+  ret_cov.count[level] = slot->cov_count;
+  ret_cov.is_full[level] = slot->cov_full;
+  memcpy(ret_cov.funcs[level], slot->cov_funcs,
+         slot->cov_count * sizeof *slot->cov_funcs);
+}
+
+
+/**************************************************************************//**
+ * @brief Send the functions called by the test at a nest level
+ * @param uint32_t - nest level of the test (ret.nest - 1)
+ * @return none
+ */
+static void retCoverageLineFormat(uint32_t level) {
+  char      ascii_buf[12];
+  uint32_t  n, next;
+  uintptr_t base = (uintptr_t)&retStart;
+
+  retIoBegin();
+  for(n = 0; n < ret_cov.count[level]; ) {
+    retPutChar('C');
+    retPutCommaSeparator();
+    retDecimalDigits(ret.next_line_number++ , 4);
+    retPutCommaSeparator();
+    retPutString("    ");
+    retPutCommaSeparator();
+    retPutString("      ");
+    retPutCommaSeparator();
+    retPutString("      ");
+    retPutCommaSeparator();
+    retPutString(ret.tag_str);
+    for(next = n + RET_COVERAGE_LINE_FUNCS;
+        (n < next) && (n < ret_cov.count[level]); n++) {
+      retPutCommaSeparator();
+      retConvIntToDecAscii(ascii_buf,
+                           (int32_t)((uintptr_t)ret_cov.funcs[level][n] - base));
+      retPutString(ascii_buf);
+    }
+    if((n == ret_cov.count[level]) && ret_cov.is_full[level]) {
+      retPutCommaSeparator();
+      retPutChar('*');
+    }
+    retPutLineFeed();
+  }
+  retIoEnd();
+}
+#endif
+
+
+#ifdef RET_VIRTUAL_CLOCK
+/**************************************************************************//**
+ * @brief Read the virtual clock (see RET_VIRTUAL_CLOCK in ret.h)
+ * @param none
+ * @return uint32_t - virtual time in RET_SYS_TICK_FUNC() units
+ */
+uint32_t retClockNow(void) {
+  ret_clock.reads++;
+  return ret_clock.now;
+}
+
+
+/**************************************************************************//**
+ * @brief Advance the virtual clock, firing the timers that expire on the way
+ * @param uint32_t - ticks to wait
  * @return none
  */
-void retAssert(int assert_condition, ret_param_t *param, int line_number,
-               char *file_name) {
-
-  if(assert_condition) {
-    return;
-  } else {
-    char assert_buf[128];
-
-#ifndef RET_NO_PRINTF
-    sprintf(assert_buf, "Assert at line %d of %s == %d", line_number, file_name,
-            param->retval);
-#else
-    char ascii_buf[12];
-
-    assert_buf[0] = '\0';
-    strcat(assert_buf, "Assert at line ");
-    retConvIntToDecAscii(ascii_buf, line_number);
-    strcat(assert_buf, ascii_buf);
-    strcat(assert_buf, " of ");
-    strcat(assert_buf, file_name);
-    strcat(assert_buf, " == ");
-    retConvIntToDecAscii(ascii_buf, param->retval);
-    strcat(assert_buf, ascii_buf);
-#endif
-    retInfoLineFmt(assert_buf);
-    longjmp (ret_env[ret.nest - 1].env, -1);
-  }
+void retClockSleep(uint32_t ticks) {
+  ret_clock.reads++;
+  retClockAdvance(ret_clock.now + ticks);
 }
 
 
 /**************************************************************************//**
- * @brief Append information line to output buffer
+ * @brief Start a virtual timer owned by the executing test
  *
- * Construct information line and pass to output buffer for display at the
- * conclusion of the test.
+ * The callback runs from retClockSleep() (or the async scheduler) with the
+ * virtual clock set to the expiry time.  The id is valid until a one-shot
+ * timer expires or the timer is cancelled.
  *
- * @param char* - message to append to output report buffer
- * @return none
+ * @param uint32_t - ticks to the first expiry
+ * @param uint32_t - reload period in ticks (0 = one-shot)
+ * @param ret_timer_func_t* - expiry callback
+ * @param void* - callback argument
+ * @return int32_t - timer id or -1 if RET_CLOCK_MAX_TIMERS are running
  */
-void retInfoLineFmt(const char* str)
-{
-  retInfoLine(str, RET_NO_PAUSE);
+int32_t retClockTimer(uint32_t ticks, uint32_t period, ret_timer_func_t* func,
+                      void* arg) {
+  ret_timer_t* timer;
+  int32_t id;
+
+  for(id = 0; id < RET_CLOCK_MAX_TIMERS; id++) {
+    timer = &ret_clock.timers[id];
+    if(timer->func != NULL)
+      continue;
+
+    timer->func = func;
+    timer->arg = arg;
+    timer->deadline = ret_clock.now + ticks;
+    timer->period = period;
+    timer->order = ret_clock.order++;
+    timer->owner = NULL;
+    timer->case_index = 0;
+    if(ret.nest != 0) {
+      timer->owner = ret_env[ret.nest - 1].test;
+      timer->case_index = ret_env[ret.nest - 1].case_index;
+    }
+    return id;
+  }
+  return -1;
 }
 
 
 /**************************************************************************//**
- * @brief Append information line to output buffer with pause option
- * @param char* - message to append to output report buffer
- * @param bool - 1|0 : send msg immediately|send msg at completion of test
+ * @brief Cancel a virtual timer
+ * @param int32_t - timer id from retClockTimer()
  * @return none
  */
-void retInfoLine(const char* str, bool pause)
-{
-  retFormatLine('I', str, pause);
+void retClockCancel(int32_t id) {
+  if((id >= 0) && (id < RET_CLOCK_MAX_TIMERS))
+    ret_clock.timers[id].func = NULL;
 }
 
 
 /**************************************************************************//**
- * @brief Send search line to communication port immediately
- * @param char* - message to append to output report buffer
+ * @brief Fire the timers due up to a virtual time & set the clock to it
+ *
+ * Timers fire in deadline order and in start order for equal deadlines.  A
+ * periodic timer is reloaded before its callback, which may cancel it.
+ *
+ * @param uint32_t - virtual time to advance to
  * @return none
  */
-static void retSearchLine(const char* str)
-{
-  retFormatLine('S', str, RET_NO_PAUSE);
+static void retClockAdvance(uint32_t target) {
+  ret_timer_t* timer;
+  ret_timer_t* next;
+  ret_timer_func_t* func;
+  void*     arg;
+  uint32_t  n;
+
+  for(;;) {
+    next = NULL;
+    for(n = 0; n < RET_CLOCK_MAX_TIMERS; n++) {
+      timer = &ret_clock.timers[n];
+      if((timer->func == NULL) || ((int32_t)(target - timer->deadline) < 0))
+        continue;
+      /* A rehearsal (RET_CACHE_WARM) fires the timers it started only */
+      if(ret_cache.is_rehearsal &&
+         ((timer->owner != ret_env[ret.nest - 1].test) ||
+          (timer->case_index != ret_env[ret.nest - 1].case_index)))
+        continue;
+      if((next == NULL) ||
+         ((int32_t)(timer->deadline - next->deadline) < 0) ||
+         ((timer->deadline == next->deadline) &&
+          ((int32_t)(timer->order - next->order) < 0)))
+        next = timer;
+    }
+    if(next == NULL)
+      break;
+
+    ret_clock.now = next->deadline;
+    func = next->func;
+    arg = next->arg;
+    if(next->period != 0) {
+      next->deadline += next->period;
+      next->order = ret_clock.order++;
+    } else {
+      next->func = NULL;
+    }
+    func(arg);
+  }
+
+  /* A callback that slept may have passed the target already */
+  if((int32_t)(target - ret_clock.now) > 0)
+    ret_clock.now = target;
 }
 
 
 /**************************************************************************//**
- * @brief Send msg to output buffer or to comm port immediately
- * @param char - message type character
- * @param char* - message to append to output report buffer
- * @param bool - 1|0 : send msg immediately|send msg at completion of test
+ * @brief Cancel the timers started by the completed test of a nest level
+ * @param ret_env_t* - nest level of the test
  * @return none
  */
-static void retFormatLine(char msg_type, const char* str, bool pause)
-{
-  bool save_pause;
+static void retClockCancelOwner(ret_env_t* level) {
+  uint32_t n;
 
-  save_pause = ret_buf.is_pause;
-  ret_buf.is_pause = pause;
-  retPutChar(msg_type);
-  retPutCommaSeparator();
-  retDecimalDigits(ret.next_line_number++ , 4);
-  retPutCommaSeparator();
-  retPutString("    ");
-  retPutCommaSeparator();
-  retPutString("      ");
-  retPutCommaSeparator();
-  if(strlen(str) > RET_MAX_TAG_STRING_SIZE) {
-    str = "<string exceeds length limit>";
+  for(n = 0; n < RET_CLOCK_MAX_TIMERS; n++) {
+    if((ret_clock.timers[n].owner == level->test) &&
+       (ret_clock.timers[n].case_index == level->case_index))
+      ret_clock.timers[n].func = NULL;
   }
-  retPutString(str);
-  retPutLineFeed();
-  ret_buf.is_pause = save_pause;
 }
 
 
 /**************************************************************************//**
- * @brief Send test result to output buffer
+ * @brief Send the virtual time spent by a test (if any) to output buffer
  * @param ret_retval_t - return value of test
- * @param uint32_t - elapsed time for test execution
+ * @param ret_env_t* - nest level of the test
  * @return none
  */
-static void retTestLineFormat(ret_retval_t retval, uint32_t elapsed_time) {
-  retPutChar('T');
+static void retClockLineFormat(ret_retval_t retval, ret_env_t* level) {
+  if(ret_clock.now == level->vtimer)
+    return;
+
+  retIoBegin();
+  retPutChar('V');
   retPutCommaSeparator();
   retDecimalDigits(ret.next_line_number++ , 4) ;
   retPutCommaSeparator();
   retPutString(RET_RETVAL_STR[retval]);
   retPutCommaSeparator();
-  retDecimalDigits(elapsed_time , 6);
+  retDecimalDigits(ret_clock.now - level->vtimer, 6);
+  retPutCommaSeparator();
+  retPutString("      ");
   retPutCommaSeparator();
   retPutString(ret.tag_str);
   retPutLineFeed();
+  retIoEnd();
 }
+#endif
 
-/* Helper routine to reverse the order of string characters */
-static void str_rev(char *start, char *end) {
-  char temp;
-  while(end > start) {
-    temp = *end;
-    *end-- = *start;
-    *start++ = temp;
+
+#ifdef RET_FAIL_LOG
+/**************************************************************************//**
+ * @brief Hold an information line of the running test (see RET_FAIL_LOG)
+ *
+ * A line that does not fit is counted against the last held line of the test.
+ *
+ * @param char* - message
+ * @return none
+ */
+static void retLogAppend(const char* str) {
+  ret_env_t*  level = &ret_env[ret.nest - 1];
+  ret_log_entry_t entry;
+  uint32_t    len = strlen(str) + 1;
+  uint32_t    pos, last = RET_FAIL_LOG_SIZE;
+
+  if(ret_log.size + sizeof entry + len <= RET_FAIL_LOG_SIZE) {
+    entry.test = level->test;
+    entry.case_index = level->case_index;
+    entry.len = len;
+    entry.dropped = 0;
+    memcpy(ret_log.buf + ret_log.size, &entry, sizeof entry);
+    memcpy(ret_log.buf + ret_log.size + sizeof entry, str, len);
+    ret_log.size += sizeof entry + len;
+    return;
+  }
+
+  for(pos = 0; pos < ret_log.size; pos += sizeof entry + entry.len) {
+    memcpy(&entry, ret_log.buf + pos, sizeof entry);
+    if((entry.test == level->test) && (entry.case_index == level->case_index))
+      last = pos;
   }
+  if(last == RET_FAIL_LOG_SIZE) {
+    ret_log.lost++;
+    return;
+  }
+  memcpy(&entry, ret_log.buf + last, sizeof entry);
+  entry.dropped++;
+  memcpy(ret_log.buf + last, &entry, sizeof entry);
 }
 
 
 /**************************************************************************//**
- * @brief Convert signed long binary to signed decimal ascii
- * @param char* - pointer to destination buffer (minimum size = 12)
- * @param int32_t - binary signed input value
+ * @brief Release the held lines of a completed test
+ *
+ * Lines of a passed test are discarded.  A failed test reports its own lines
+ * and the lines of the tests at lower nest levels in the order they were held
+ * (lines of waiting async leaves are kept).
+ *
+ * @param ret_env_t* - nest level of the test (NULL = all lines)
+ * @param bool - true to report the lines, false to discard them
  * @return none
  */
-void retConvIntToDecAscii(char* dst_buf, int32_t val) {
-  char  *tmp_str = dst_buf;
-  bool    neg_flag = false;
+static void retLogRelease(ret_env_t* level, bool flush) {
+  ret_log_entry_t entry;
+  ret_env_t*  owner;
+  uint32_t    pos, next, size = 0;
+  bool        is_release;
+
+  for(pos = 0; pos < ret_log.size; pos = next) {
+    memcpy(&entry, ret_log.buf + pos, sizeof entry);
+    next = pos + sizeof entry + entry.len;
+
+    is_release = (level == NULL);
+    for(owner = ret_env; !is_release && (owner <= level); owner++) {
+      is_release = (entry.test == owner->test) &&
+                   (entry.case_index == owner->case_index) &&
+                   (flush || (owner == level));
+    }
 
-  /* Sign logic */
-  if(val < 0) {
-    /* Make input binary value positive */
-    val = -val;
-    neg_flag = true;
+    if(!is_release) {
+      memmove(ret_log.buf + size, ret_log.buf + pos, next - pos);
+      size += next - pos;
+    } else if(flush) {
+      retFormatLine('I', ret_log.buf + pos + sizeof entry, RET_NO_PAUSE);
+      if(entry.dropped != 0)
+        retLogCountLine(RET_LOG_DROP_MSG, entry.dropped, RET_LOG_DROP_END_MSG);
+    } else {
+      ret_log.discarded += 1 + entry.dropped;
+    }
   }
+  ret_log.size = size;
 
-  /* Characters are reversed by conversion */
-  do {
-    *tmp_str++ = (char)RET_DIGITS[val % 10];
-  } while(val /= 10);
-
-  /* Add negative sign character if required */
-  if(neg_flag) {
-    *tmp_str++ = '-';
+  if(flush && (ret_log.lost != 0)) {
+    retLogCountLine(RET_LOG_DROP_MSG, ret_log.lost, RET_LOG_DROP_END_MSG);
+    ret_log.lost = 0;
   }
+}
 
-  /* Add zero terminator to temp string */
-  *tmp_str = '\0';
 
-  /* Reverse characters in temp string (exclude terminator) */
-  str_rev(dst_buf, tmp_str - 1);
+/**************************************************************************//**
+ * @brief Report an information line with a count (ie: lines dropped)
+ * @param char* - message before the count
+ * @param uint32_t - count
+ * @param char* - message after the count
+ * @return none
+ */
+static void retLogCountLine(const char* msg, uint32_t count,
+                            const char* end_msg) {
+  char line_buf[64];
+  char ascii_buf[12];
+
+  line_buf[0] = '\0';
+  strcat(line_buf, msg);
+  retConvIntToDecAscii(ascii_buf, (int32_t)count);
+  strcat(line_buf, ascii_buf);
+  strcat(line_buf, end_msg);
+  retFormatLine('I', line_buf, RET_NO_PAUSE);
 }
+#endif
 
 
+#ifdef RET_RESUME
 /**************************************************************************//**
- * @brief Convert unsigned long binary to unsigned decimal ascii & right justify
- * into array of 'width' space characters for a vertically aligned output
- * @param uint32_t - binary unsigned input value
- * @param uint32_t - Length of text area in which to right justify char output
+ * @brief Check the progress record at the start of a run
+ *
+ * A valid record of the same test tag & order seed resumes the run (counts
+ * and line numbers continue), otherwise a new record is started.
+ *
+ * @param ret_param_t* - pointer to user control structure
  * @return none
  */
-static void retDecimalDigits(uint32_t value, uint32_t width) {
-    static const char blanks[] = "          ";
-  static char work[sizeof blanks];
-  uint32_t next;
-  char* ch_ptr;
-
-  if((width > 0) && (width < sizeof work - 1)) {
-    strcpy(work, blanks);
-    ch_ptr = work + width;
-    *ch_ptr = '\0';
-    do {
-      next = value / 10 ;
-      *-- ch_ptr = (char)('0' + value - next * 10);
-      value = next ;
-    } while(value && ch_ptr > work);
+static void retResumeStart(ret_param_t* param) {
+  ret_resume_t* record;
+  uint32_t    selection = retResumeHash(param->test_tag,
+                                        strlen(param->test_tag));
+
+  /* Another order seed is another run (the record follows the order) */
+  selection ^= param->order_seed;
+
+  ret_resume.is_resuming = false;
+  ret_resume.is_skipped = false;
+  ret_resume.is_crashed = false;
+  ret_resume.parked_count = 0;
+  ret_resume.record = NULL;
+  if((param->mode != RET_MODE_EXE) || ret_soak.is_active)
+    return;
 
-    retPutString(work);
+#ifdef RET_HOST
+  record = (ret_resume_t*)retHostResumeRecord(sizeof *record);
+  if(record == NULL)
+    return;
+#else
+  record = &ret_resume_record;
+#endif
+  ret_resume.record = record;
+
+  if((record->magic == RET_RESUME_MAGIC) &&
+     (record->selection == selection) && (record->tag[0] != '\0') &&
+     (record->checksum == retResumeHash(record,
+                                        offsetof(ret_resume_t, checksum)))) {
+    ret.next_line_number = record->line_number;
+    ret.pass = record->run.pass;
+    ret.fail = record->run.fail;
+    ret.skip = record->run.skip;
+    param->tag_found = 1;
+    ret_resume.is_resuming = true;
+    ret_resume.parked_count = record->parked_count;
+    memcpy(ret_resume.parked, record->parked, sizeof ret_resume.parked);
+    retInfoLine(RET_RESUME_MSG, RET_PAUSE);
+    return;
   }
+
+  memset(record, 0, sizeof *record);
+  record->magic = RET_RESUME_MAGIC;
+  record->selection = selection;
+  record->checksum = retResumeHash(record, offsetof(ret_resume_t, checksum));
 }
 
 
 /**************************************************************************//**
- * @brief Output char to the output buffer
+ * @brief Position a resumed run at an entered test
  *
- * retPutChar should buffer characters until it sees a linefeed.
- * On receipt of linefeed retPutChar may may do a synchronous output
- * through a comm channel depending on ret_buf.is_pause
+ * Tests that lead to the recorded test are executed with the rollup of their
+ * children restored.  Tests before it were completed (skipped) and the
+ * recorded test itself was running at the reset unless it had completed.
+ * Async leaves that were waiting at the reset were running as well, wherever
+ * they are in the walk.
  *
- * @param char - character
- * @return none
+ * @param none
+ * @return bool - true if the test is to be entered (false = skipped)
  */
-static void retPutChar(const char c)
-{
-  if(ret_buf.next_in < ret_buf.buf + RET_REPORT_BUF_SIZE) {
-    *ret_buf.next_in++ = c;
-    if('\n' == c && ret_buf.is_pause)
-      retSendBuffer();
+static bool retResumeEnter(void) {
+  ret_resume_t* record = ret_resume.record;
+  size_t      len = (size_t)(ret.tag_ptr - ret.tag_str);
+  ret_resume_count_t* count;
+  uint32_t    hash;
+  uint32_t    n;
+
+  if(ret_resume.parked_count != 0) {
+    hash = retResumeHash(ret.tag_str, (uint32_t)len);
+    for(n = 0; n < ret_resume.parked_count; n++) {
+      if(ret_resume.parked[n] != hash)
+        continue;
+      ret_resume.parked[n] = ret_resume.parked[--ret_resume.parked_count];
+      ret_resume.is_crashed = true;
+      return true;
+    }
+  }
+  if(!ret_resume.is_resuming)
+    return true;
+
+  if(strncmp(record->tag, ret.tag_str, len) != 0) {
+    ret_resume.is_skipped = true;
+    return false;
   }
+
+  if(record->tag[len] == RET_TOKEN_DELIMITER) {
+    /* Leads to the recorded test */
+    if(ret.nest < RET_MAX_NEST_SIZE) {
+      count = &record->level[ret.nest];
+      ret_env[ret.nest].pass = count->pass;
+      ret_env[ret.nest].fail = count->fail;
+      ret_env[ret.nest].skip = count->skip;
+    }
+    return true;
+  }
+
+  if(record->tag[len] != '\0') {
+    ret_resume.is_skipped = true;
+    return false;
+  }
+
+  /* Recorded test - continue the run after it */
+  ret_resume.is_resuming = false;
+  if(record->is_done) {
+    ret_resume.is_skipped = true;
+    return false;
+  }
+  ret_resume.is_crashed = true;
+  return true;
 }
 
 
 /**************************************************************************//**
- * @brief Output string to the output buffer
- * @param char* - string
+ * @brief Check & clear the skipped flag of the exiting test
+ * @param none
+ * @return bool - true if the test was completed before a reset
+ */
+static bool retResumeSkipped(void) {
+  bool is_skipped = ret_resume.is_skipped;
+
+  ret_resume.is_skipped = false;
+  return is_skipped;
+}
+
+
+/**************************************************************************//**
+ * @brief Record the current test & the leaf counts in the progress record
+ * @param bool - true if the test completed, false if it was entered
  * @return none
  */
-static void retPutString(const char* str)
-{
-  for(char c = *str++; c; c = *str++)
-    retPutChar(c);
+static void retResumeRecord(bool is_done) {
+  ret_resume_t* record = ret_resume.record;
+  uint32_t n;
+
+  /* Not recorded or the recorded test is not reached yet */
+  if((record == NULL) || ret_resume.is_resuming)
+    return;
+
+  record->line_number = ret.next_line_number;
+  record->run.pass = ret.pass;
+  record->run.fail = ret.fail;
+  record->run.skip = ret.skip;
+  for(n = 0; n < RET_MAX_NEST_SIZE; n++) {
+    record->level[n].pass = ret_env[n].pass;
+    record->level[n].fail = ret_env[n].fail;
+    record->level[n].skip = ret_env[n].skip;
+  }
+  record->is_done = is_done;
+  memcpy(record->tag, ret.tag_str, (size_t)(ret.tag_ptr - ret.tag_str) + 1);
+  record->parked_count = ret.async_count;
+  for(n = 0; n < ret.async_count; n++)
+    record->parked[n] = ret_async[n].path_hash;
+  record->checksum = retResumeHash(record, offsetof(ret_resume_t, checksum));
 }
 
 
 /**************************************************************************//**
- * @brief Output line feed to the output buffer
+ * @brief FNV-1a hash
+ * @param void* - data
+ * @param uint32_t - size of data in bytes
+ * @return uint32_t - hash
+ */
+static uint32_t retResumeHash(const void* data, uint32_t size) {
+  const uint8_t* byte = (const uint8_t*)data;
+  uint32_t hash = 2166136261u;
+
+  while(size--) {
+    hash ^= *byte++;
+    hash *= 16777619u;
+  }
+  return hash;
+}
+#endif
+
+
+#ifdef RET_SIGNAL
+/**************************************************************************//**
+ * @brief Install the fault handlers on the alternate signal stack
  * @param none
  * @return none
  */
-static void retPutLineFeed(void) {
-#if 1
-  retPutChar ('\r');
-#endif
-  retPutChar('\n');
+static void retSignalInstall(void) {
+  struct sigaction action;
+  stack_t   stack;
+  uint32_t  n;
+
+  stack.ss_sp = ret_signal.stack;
+  stack.ss_size = sizeof ret_signal.stack;
+  stack.ss_flags = 0;
+  sigaltstack(&stack, &ret_signal.save_stack);
+
+  memset(&action, 0, sizeof action);
+  action.sa_sigaction = retSignalHandler;
+  action.sa_flags = SA_SIGINFO | SA_ONSTACK | SA_NODEFER;
+  sigemptyset(&action.sa_mask);
+  for(n = 0; n < sizeof RET_SIGNALS / sizeof *RET_SIGNALS; n++)
+    sigaction(RET_SIGNALS[n], &action, &ret_signal.save_action[n]);
 }
 
 
 /**************************************************************************//**
- * @brief Output field separator feed to the output buffer
+ * @brief Restore the handlers & signal stack in place before retStart()
  * @param none
  * @return none
  */
-static void retPutCommaSeparator(void) {
-  retPutChar(',');
+static void retSignalRestore(void) {
+  uint32_t n;
+
+  for(n = 0; n < sizeof RET_SIGNALS / sizeof *RET_SIGNALS; n++)
+    sigaction(RET_SIGNALS[n], &ret_signal.save_action[n], NULL);
+  sigaltstack(&ret_signal.save_stack, NULL);
 }
 
 
 /**************************************************************************//**
- * @brief Send output buffer to the communication channel
- * @param none
+ * @brief Fault handler - return to the environment of the faulting test
+ *
+ * A fault outside of a test (or in the report output) is not recovered: the
+ * default action is restored and the faulting instruction raises it again.
+ *
+ * @param int - signal number
+ * @param siginfo_t* - signal information (faulting address)
+ * @param void* - interrupted context (not used)
  * @return none
  */
-static void retSendBuffer(void) {
-  if(ret_buf.next_in != ret_buf.buf) {
-    *ret_buf.next_in++ = '\0';
-    RET_SEND_BUF(ret_buf.buf)
-    ret_buf.next_in = ret_buf.buf;
+static void retSignalHandler(int sig, siginfo_t* info, void* context) {
+  (void)context;
+  if((ret.nest == 0) || (ret.io_depth != 0)) {
+    signal(sig, SIG_DFL);
+    return;
   }
+
+  ret_signal.sig = sig;
+  ret_signal.addr = info->si_addr;
+  RET_LONGJMP(ret_env[ret.nest - 1].env, -2);
 }
 
 
+/**************************************************************************//**
+ * @brief Report the fault of the current test
+ * @param none
+ * @return ret_retval_t - RET_FAULT
+ */
+static ret_retval_t retSignalFault(void) {
+  char      fault_buf[64];
+  char*     ch_ptr;
+  uintptr_t addr = (uintptr_t)ret_signal.addr;
+  int32_t   shift;
+
+  fault_buf[0] = '\0';
+  strcat(fault_buf, RET_SIGNAL_MSG);
+  retConvIntToDecAscii(fault_buf + strlen(fault_buf), ret_signal.sig);
+  strcat(fault_buf, RET_SIGNAL_ADDR_MSG);
+  ch_ptr = fault_buf + strlen(fault_buf);
+  for(shift = sizeof addr * 8 - 4; shift >= 0; shift -= 4)
+    *ch_ptr++ = RET_DIGITS[(addr >> shift) & 0xF];
+  *ch_ptr = '\0';
+
+  RET_TRACE_EVENT('I', RET_SIGNAL_MSG, (uint32_t)ret_signal.sig);
+#ifdef RET_FAIL_LOG
+  /* Report the held lines of the test ahead of the fault (never held) */
+  retLogRelease(&ret_env[ret.nest - 1], true);
+#endif
+  retFormatLine('I', fault_buf, RET_NO_PAUSE);
+  return RET_FAULT;
+}
+#endif
+
+
 #ifdef __cplusplus
 }
 #endif
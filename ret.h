@@ -47,8 +47,10 @@ extern "C" {
 #include <string.h>
 #include <stdbool.h>
 /* Includes for RET_SYS_TICK_FUNC() and RET_SEND_BUF() macros */
+#ifndef RET_HOST
 #include "stm32h5xx_hal.h"
 #include "uart.h"
+#endif
 
 
 /******************************************************************************
@@ -58,11 +60,36 @@ extern "C" {
  * @brief RET memory controls
  *
  * The following block of definitions set the size limits of buffers and test
- * recursion.  Adjust according to target device memory constraints.
+ * recursion.  Adjust according to target device memory constraints (or
+ * override them from the compiler command line).
  */
+#ifndef RET_REPORT_BUF_SIZE
 #define RET_REPORT_BUF_SIZE       0x1000
+#endif
+#ifndef RET_MAX_TAG_STRING_SIZE
 #define RET_MAX_TAG_STRING_SIZE   256
+#endif
+#ifndef RET_MAX_NEST_SIZE
 #define RET_MAX_NEST_SIZE         6
+#endif
+#ifndef RET_MAX_ASYNC_SIZE
+#define RET_MAX_ASYNC_SIZE        4 /**< Async leaves waiting at once (>= 1) */
+#endif
+#ifndef RET_SOAK_MAX_TESTS
+#define RET_SOAK_MAX_TESTS        32 /**< Leaves with soak statistics */
+#endif
+#ifndef RET_SOAK_HIST_SIZE
+#define RET_SOAK_HIST_SIZE        8 /**< Soak latency histogram buckets */
+#endif
+#ifndef RET_PERF_MAX_COUNTERS
+#define RET_PERF_MAX_COUNTERS     6 /**< Counters of a ret_perf_port_t */
+#endif
+#ifndef RET_SOAK_REPORT_TICKS
+#define RET_SOAK_REPORT_TICKS     60000 /**< Soak progress report period */
+#endif
+#ifndef RET_MAX_FAILED_TAGS
+#define RET_MAX_FAILED_TAGS       16 /**< Failed tags checked by dependents */
+#endif
 
 /**
  * @brief Root tag that prefixes all test tag strings
@@ -76,6 +103,140 @@ extern "C" {
 /* Optional preprocessor define to reduce code size */
 #define RET_NO_PRINTF
 
+/**
+ * @brief Optional execution trace (define RET_TRACE to enable)
+ *
+ * Begin/end events of executed tests, report flushes, user spans and assert
+ * events are captured with RET_TRACE_TICK_FUNC() timestamps into a buffer of
+ * RET_TRACE_BUF_SIZE events.  The trace is sent as X lines before DONE:
+ *   X,line,event,time,nest,arg,name
+ * The first X line is a header with event H, the timestamp frequency in Hz as
+ * time and the number of dropped events as arg.  Events are B (begin), E (end)
+ * and I (instant).  tools/ret_trace.c converts the X lines of a report to
+ * Chrome trace-event JSON (chrome://tracing or Perfetto).
+ * A target with a cycle counter may define RET_TRACE_TICK_FUNC() and
+ * RET_TRACE_TICK_HZ for higher resolution timestamps.
+ */
+#ifdef RET_TRACE
+#ifndef RET_TRACE_BUF_SIZE
+#define RET_TRACE_BUF_SIZE        512
+#endif
+#ifndef RET_TRACE_TICK_FUNC
+#ifdef RET_HOST
+#define RET_TRACE_TICK_FUNC()     retHostTraceTick()
+#define RET_TRACE_TICK_HZ         1000000
+#else
+#define RET_TRACE_TICK_FUNC()     RET_SYS_TICK_FUNC()
+#define RET_TRACE_TICK_HZ         1000
+#endif
+#endif
+#endif
+
+/**
+ * @brief Optional coverage map for change-based selection (RET_COVERAGE)
+ *
+ * Define RET_COVERAGE in a host build (RET_HOST) and compile the tests and
+ * the code under test, but not ret.c or the retHost...() functions, with
+ * -finstrument-functions.  Each executed test then reports the instrumented
+ * functions it called itself (calls made by its child tests are reported by
+ * the children):
+ *   C,line,,,,tag,offset,...
+ * Offsets are function addresses relative to retStart().  An offset of *
+ * marks a test that called more than RET_COVERAGE_MAX_FUNCS functions.
+ * tools/ret_select.c maps the offsets to source files and selects the tests
+ * affected by a change.
+ */
+#ifdef RET_COVERAGE
+#ifndef RET_COVERAGE_MAX_FUNCS
+#define RET_COVERAGE_MAX_FUNCS    256 /**< Functions recorded per test */
+#endif
+#endif
+
+/**
+ * @brief Optional virtual clock for time-dependent tests (RET_VIRTUAL_CLOCK)
+ *
+ * Define RET_VIRTUAL_CLOCK and have the code under test read and wait on
+ * RET_CLOCK_NOW() and RET_CLOCK_SLEEP() (ie: map HAL_GetTick/HAL_Delay to
+ * them in the test build).  Virtual time starts at 0 in retStart() and only
+ * advances when a test sleeps or an async leaf waits, so a wait takes no real
+ * time.  Timers started with retClockTimer() fire in deadline order (start
+ * order for equal deadlines) as virtual time passes them; the timers a test
+ * started are cancelled when it completes.  The virtual time spent by a test
+ * is reported after its T or B line:
+ *   V,line,status,virtual time,,tag
+ * T and B lines keep the real elapsed time.  An async leaf whose last poll
+ * read the virtual clock waits on it: its timeout counts virtual time and the
+ * scheduler advances virtual time one tick per pass in which no waiting leaf
+ * completed.  A leaf whose poll did not read it (ie: waits on real I/O) times
+ * out in real time, and virtual time does not advance while it waits.
+ */
+#ifdef RET_VIRTUAL_CLOCK
+#ifndef RET_CLOCK_MAX_TIMERS
+#define RET_CLOCK_MAX_TIMERS      16 /**< Virtual timers running at once */
+#endif
+#endif
+
+/**
+ * @brief Optional failure-only information log (define RET_FAIL_LOG to enable)
+ *
+ * Information lines that a running test reports without RET_PAUSE (ie: with
+ * retInfoLineFmt) are held in a log of RET_FAIL_LOG_SIZE bytes instead of the
+ * report buffer.  The lines of a test that passes are discarded and counted.
+ * The lines of a test that fails are reported ahead of its T line together
+ * with the held lines of the tests it was run by.  Lines that did not fit in
+ * the log are reported as a truncation line:
+ *   I,line,,,,log truncated: n lines dropped
+ * The number of discarded lines is reported before DONE.  RET_PAUSE lines
+ * are sent at once as before.
+ */
+#ifdef RET_FAIL_LOG
+#ifndef RET_FAIL_LOG_SIZE
+#define RET_FAIL_LOG_SIZE         1024
+#endif
+#endif
+
+/**
+ * @brief Optional resume after a reset (define RET_RESUME to enable)
+ *
+ * An executed run (not search or soak) keeps a progress record in RAM that is
+ * not initialized at reset (RET_NOINIT section): the tag of the last test
+ * entered or completed, the async leaves waiting, the leaf counts of the run
+ * and of each nest level and a checksum.  If retStart() finds a valid record
+ * of the same test tag the run resumes after a reset: the tests completed
+ * before the reset are not executed or reported again and the test that was
+ * running is reported with status CRASH instead of being executed.  Async
+ * leaves that were waiting at the reset are reported with status CRASH as
+ * well.  The record is cleared when the run is done.  A host build keeps the
+ * record in a file mapped by retHostResumeRecord()
+ * (see port/ret_resume_mmap.c).
+ */
+#ifdef RET_RESUME
+#ifndef RET_NOINIT
+#define RET_NOINIT                __attribute__((section(".noinit")))
+#endif
+#endif
+
+/**
+ * @brief Optional fault recovery of POSIX host builds (define RET_SIGNAL)
+ *
+ * SIGSEGV, SIGFPE and SIGBUS handlers run on an alternate stack of
+ * RET_SIGNAL_STACK_SIZE bytes (so a stack overflow is caught as well) and
+ * return to the engine through the environment of the faulting test.  The
+ * test is reported with status FAULT after an information line:
+ *   I,line,,,,fault: signal n at 0x...
+ * and the run continues with the next test.  The handlers are installed for
+ * the duration of retStart().  State the test left behind (ie: held locks or
+ * allocated memory) is not recovered.
+ */
+#ifdef RET_SIGNAL
+#ifndef RET_HOST
+#error "RET_SIGNAL requires a host build (RET_HOST)"
+#endif
+#ifndef RET_SIGNAL_STACK_SIZE
+#define RET_SIGNAL_STACK_SIZE     0x10000
+#endif
+#endif
+
 
 /******************************************************************************
 * P U B L I C    M A C R O S
@@ -86,15 +247,46 @@ extern "C" {
  * Macro to give RET access to a system timer function for calculating the
  * elapsed time to execute a test function.  Time statistics are presented in
  * the test report at the conclusion of the test.
+ *
+ * A host build (RET_HOST defined) uses retHostTick(), which the host
+ * application provides.
  */
+#ifdef RET_HOST
+#define RET_SYS_TICK_FUNC() retHostTick()
+#else
 #define RET_SYS_TICK_FUNC() HAL_GetTick()
+#endif
+
+/**
+ * @brief Clock macros for code under test (see RET_VIRTUAL_CLOCK)
+ *
+ * Without RET_VIRTUAL_CLOCK they read the system timer and busy-wait.
+ */
+#ifdef RET_VIRTUAL_CLOCK
+#define RET_CLOCK_NOW()           retClockNow()
+#define RET_CLOCK_SLEEP(ticks)    retClockSleep(ticks)
+#else
+#define RET_CLOCK_NOW()           RET_SYS_TICK_FUNC()
+#define RET_CLOCK_SLEEP(ticks)                                \
+  do {                                                        \
+    uint32_t ret_sleep_start = RET_SYS_TICK_FUNC();           \
+    while(RET_SYS_TICK_FUNC() - ret_sleep_start < (ticks));   \
+  } while(0)
+#endif
 
 /**
  * @brief Communication Tx macro
  *
  * Macro to give RET access to a communication transmission function
+ *
+ * A host build (RET_HOST defined) uses retHostSend(), which the host
+ * application provides.
  */
+#ifdef RET_HOST
+#define RET_SEND_BUF(x)  retHostSend((x));
+#else
 #define RET_SEND_BUF(x)  uartWriteString((x));
+#endif
 
 /**
  * @brief Test function diagnostic macro
@@ -105,6 +297,86 @@ extern "C" {
  */
 #define RET_ASSERT(x) retAssert((x),param,(__LINE__),(__FILE__))
 
+/**
+ * @brief Parameterized test case table initializer
+ *
+ * Builds a ret_cases_t from a const array of test vectors:
+ * @code
+ * static const vec_t vectors[] = {...};
+ * static const ret_cases_t vector_cases = RET_CASES(vectors);
+ * static ret_test_t tests[] = {
+ *   {VectorTest, "VectorTest", &vector_cases}
+ * };
+ * @endcode
+ */
+#define RET_CASES(table) { (table), sizeof *(table), \
+                           sizeof (table) / sizeof *(table) }
+
+/**
+ * @brief Current case of a parameterized leaf as a pointer to 'type'
+ */
+#define RET_CASE(type) ((const type*)param->test_case)
+
+/**
+ * @brief User trace span macros (see RET_TRACE)
+ *
+ * Mark a section of a test in the execution trace.  The name must be a
+ * string constant.  The macros are empty if RET_TRACE is not defined.
+ */
+#ifdef RET_TRACE
+#define RET_TRACE_BEGIN(name) retTraceEvent('B', (name), 0)
+#define RET_TRACE_END(name)   retTraceEvent('E', (name), 0)
+#else
+#define RET_TRACE_BEGIN(name)
+#define RET_TRACE_END(name)
+#endif
+
+/**
+ * @brief Cooperative (asynchronous) leaf macros
+ *
+ * An async leaf returns to the engine while it waits and is resumed at the
+ * wait point by the engine scheduler, which interleaves the waiting leaves of
+ * a test list before the list completes.  Each async leaf keeps its own start
+ * time, timeout and result report.  Local variables do not survive a wait
+ * (use statics or param->async->user).
+ * @code
+ * static ret_retval_t RadioTxTest(ret_param_t* param) {
+ *   RET_MODE_SEARCH();
+ *   RET_ASYNC_BEGIN(100);            // Timeout in RET_CLOCK_NOW() units
+ *   radioSend(packet);
+ *   RET_AWAIT(radioTxComplete());
+ *   RET_ASSERT(radioStatus() == OK);
+ *   RET_ASYNC_END();
+ * }
+ * @endcode
+ */
+#define RET_ASYNC_BEGIN(ticks)                          \
+  switch(param->async->line) {                          \
+    case 0:                                             \
+      param->async->timeout = (ticks);
+
+/* The resume label is entered from the switch only (no fall-through) */
+#define RET_AWAIT(cond)                                 \
+  do {                                                  \
+    param->async->line = __LINE__;                      \
+    if(0) {                                             \
+      case __LINE__:;                                   \
+    }                                                   \
+    if(!(cond))                                         \
+      return RET_PENDING;                               \
+  } while(0)
+
+#define RET_YIELD()                                     \
+  do {                                                  \
+    param->async->line = __LINE__;                      \
+    return RET_PENDING;                                 \
+    case __LINE__:;                                     \
+  } while(0)
+
+#define RET_ASYNC_END()                                 \
+  }                                                     \
+  return RET_PASS
+
 /**
  * @brief RET search/skip macro
  *
@@ -129,7 +401,11 @@ typedef enum {
   RET_PASS,
   RET_FAIL,
   RET_ERR_TIMEOUT,
-  RET_ERR_TAG  /**< Test tree is too deep for RET...SIZE definitions */
+  RET_ERR_TAG,  /**< Test tree is too deep for RET...SIZE definitions */
+  RET_PENDING,  /**< Async leaf is waiting (RET engine use only) */
+  RET_CRASH,    /**< Test was running at a reset (see RET_RESUME) */
+  RET_FAULT,    /**< Test raised a fault signal (see RET_SIGNAL) */
+  RET_BLOCKED   /**< Test not executed after a failure (see ret_test_t) */
 } ret_retval_t;
 
 /**
@@ -142,13 +418,142 @@ typedef enum {
 } ret_mode_t;
 
 /**
- * @brief RET control passed to all tests - elements 1 & 2 are set by the user
+ * @brief Report verbosity
+ *
+ * RET_REPORT_FULL emits a T line for every executed node:
+ *   T,line,status,time,net,tag
+ * RET_REPORT_SUMMARY emits T lines for failed leaves only, one aggregate
+ * line per executed branch and a run summary line before DONE:
+ *   B,line,status,time,net,tag,pass,fail,skip,child time,max child time,overhead
+ *   R,line,status,time,net,test tag,pass,fail,skip
+ * Time is the gross elapsed time and net is the time less the time spent
+ * formatting and sending report lines while the test was running (ie: the
+ * lines of its children and RET_PAUSE information lines).  Pass/fail/skip are
+ * leaf counts of the subtree, child times are the net times of the direct
+ * children and overhead is the branch net time not spent in its children.
+ * Overhead is left blank if async children overlapped (their child time may
+ * exceed the branch time).
+ * An async leaf waits in real time, so its net time also excludes the report
+ * output of the tests run while it was waiting (see RET_VIRTUAL_CLOCK for
+ * virtual time waits).
+ * Information and search lines leave the status, time and net fields blank.
+ * A branch function may change param->report for its own subtree.
+ */
+typedef enum {
+  RET_REPORT_FULL,
+  RET_REPORT_SUMMARY,
+} ret_report_t;
+
+/**
+ * @brief Cache state at the start of each executed test
+ *
+ * RET_CACHE_COLD flushes the caches with the port set by retSetCachePort()
+ * before each executed test.  RET_CACHE_WARM executes each leaf once untimed
+ * and unreported (no information lines, trace events or coverage) before the
+ * timed execution.  Leaves must be repeatable: an assert in the rehearsal
+ * fails the leaf, and an async leaf is rehearsed up to its first wait.  The
+ * time of the flush or rehearsal is excluded from the net time of the
+ * enclosing branches and from the time and timeout of the async leaves that
+ * wait meanwhile.  With RET_VIRTUAL_CLOCK a rehearsal fires only the timers
+ * it started and virtual time is set back when it ends.
+ */
+typedef enum {
+  RET_CACHE_ASIS,  /**< State left by the previous test */
+  RET_CACHE_COLD,  /**< Caches flushed before each test */
+  RET_CACHE_WARM,  /**< Leaves rehearsed before each timed execution */
+} ret_cache_t;
+
+/*
+ * Soak mode (param->soak_count or param->soak_time non-zero) repeats the
+ * selected tests and reports T lines for failed leaves only.  A progress
+ * line is sent every RET_SOAK_REPORT_TICKS and at the end of the soak,
+ * followed by one line per executed leaf (up to RET_SOAK_MAX_TESTS):
+ *   K,line,status,time,net,test tag,iterations,pass,fail,untracked
+ *   H,line,status,max time,max net,tag,pass,fail,first failed iteration,histogram
+ * Histogram bucket 0 counts net times of 0, bucket n counts net times below
+ * 2^n and the last bucket counts all longer times.  The tag is the full tag
+ * path of the leaf, as in T lines.  Untracked is the number of leaf
+ * executions without statistics (RET_SOAK_MAX_TESTS exceeded).  Each leaf
+ * with statistics keeps its tag path (RET_MAX_TAG_STRING_SIZE bytes of RAM).
+ */
+
+/**
+ * @brief Async leaf context (see RET_ASYNC_BEGIN)
+ */
+typedef struct {
+  uint32_t  line; /**< Resume point (0 = first call) */
+  uint32_t  timeout; /**< Timeout from start of test (0 = no timeout) */
+  uintptr_t user; /**< Free for leaf state that must survive a wait */
+} ret_async_t;
+
+/**
+ * @brief Performance counter port (see retSetPerfPort)
+ *
+ * Counters are started before each executed test function and stopped when
+ * the test returns (or asserts).  The counts of an async leaf are the sum of
+ * its polls.  Each reported leaf is followed by a line of counter values:
+ *   P,line,status,time,net,tag,name=value,...
+ * Ports for Linux perf_event_open (host) and the Cortex-M DWT are in port/.
+ */
+typedef struct {
+  uint32_t (*open)(void); /**< Prepare counters - returns counters available */
+  void (*start)(void); /**< Reset & start counters */
+  void (*stop)(uint32_t* counts); /**< Stop counters & read count values */
+  const char* const* names; /**< Counter names (valid after open) */
+} ret_perf_port_t;
+
+/**
+ * @brief Cache flush port (see retSetCachePort & RET_CACHE_COLD)
+ *
+ * Ports for Cortex-M7/M33 caches and a host cache sweep are in port/.
+ */
+typedef struct {
+  bool (*open)(void); /**< Prepare the flush - returns false if unavailable */
+  void (*flush)(void); /**< Clean & invalidate caches */
+} ret_cache_port_t;
+
+#ifdef RET_VIRTUAL_CLOCK
+/**
+ * @brief Virtual timer callback (see retClockTimer)
+ */
+typedef void ret_timer_func_t(void* arg);
+#endif
+
+/**
+ * @brief RET control passed to all tests - elements 1 to 8 are set by the user
+ *
+ * The user elements after mode and test_tag enable options when they are
+ * not zero, so the structure must be zero-initialized before they are set:
+ * @code
+ * ret_param_t param;
+ * retParamInit(&param, RET_MODE_EXE, RET_ROOT_TAG);
+ * param.report = RET_REPORT_SUMMARY; // Optional
+ * retStart(&param);
+ * @endcode
+ *
+ * With fail_fast set the tests of a list that follow a failed test are
+ * reported BLOCKED without being executed.  Like report, a branch function
+ * may set it for its own subtree (ie: a bring-up branch).
+ *
+ * A non-zero order_seed executes the tests of each list in an order that is
+ * derived from the seed and the tag path of the list (the cases of a
+ * parameterized leaf keep their order).  The seed is reported at the start
+ * of the run, and the same seed and test tag repeat the same order.
  */
 typedef struct {
   ret_mode_t  mode; /**< User test type (RET_MODE_EXE or RET_MODE_SEARCH) */
   char*       test_tag; /**< User test string */
+  ret_report_t report; /**< User report verbosity (default RET_REPORT_FULL) */
+  uint32_t    soak_count; /**< User soak iterations (0 = no limit) */
+  uint32_t    soak_time; /**< User soak duration in RET_SYS_TICK_FUNC() units */
+  uint32_t    order_seed; /**< User test order seed (0 = list order) */
+  ret_cache_t cache; /**< User cache state (default RET_CACHE_ASIS) */
+  bool        fail_fast; /**< User stop each list at its first failure */
   int32_t     tag_found;  /**< Search flag */
   int32_t     retval; /**< Local test function return value */
+  const void* test_case; /**< Current case of a parameterized leaf or NULL */
+  uint32_t    case_index; /**< Index of test_case in the case table */
+  ret_async_t* async; /**< Context of the current (async) leaf */
 } ret_param_t;
 
 /**
@@ -156,12 +561,43 @@ typedef struct {
  */
 typedef ret_retval_t ret_func_t(ret_param_t* param);
 
+/**
+ * @brief RET parameterized test case table (see RET_CASES)
+ */
+typedef struct {
+  const void* table; /**< First element of a const array of test cases */
+  uint32_t    size; /**< Size of one array element */
+  uint32_t    count; /**< Number of array elements */
+} ret_cases_t;
+
 /**
  * @brief RET test structure
+ *
+ * A leaf with a case table is executed once per case and each case is
+ * reported as its own node with the case index appended to the tag
+ * (ie: tag[17]).  Case ranges are selected with tag[first-last] (a search
+ * lists the leaf if its cases overlap the range).  A leaf with an empty case
+ * table is reported failed as tag[] without being executed.
+ * Tests and lists may be const (ie: in flash).  ret.hpp declares them from
+ * C++ with the tag lengths and tree limits checked at compile time.
+ * A test may list the tags of prerequisite tests executed before it:
+ * @code
+ * static const char* const send_deps[] = {"RadioInit", NULL};
+ * {RadioSendTest, "RadioSendTest", NULL, 0, send_deps}
+ * @endcode
+ * If a prerequisite failed (any case of a parameterized leaf or any leaf of a
+ * branch) the test is reported BLOCKED, with an information line naming the
+ * prerequisite, and is not executed.  Blocked tests count as skipped (a
+ * blocked branch walks its list like an unselected branch and counts each
+ * leaf of its subtree) and block their own dependents.  Up to
+ * RET_MAX_FAILED_TAGS failed tags are kept per run (or soak iteration).
  */
 typedef struct {
   ret_func_t* func;
   const char* tag;
+  const ret_cases_t* cases; /**< Optional case table (NULL if not used) */
+  uint32_t    tag_len; /**< Tag length (0 = determined at run time) */
+  const char* const* deps; /**< Optional NULL terminated prerequisite tags */
 } ret_test_t;
 
 /**
@@ -169,22 +605,58 @@ typedef struct {
  */
 typedef struct {
   uint32_t    size;
-  ret_test_t* first;
+  const ret_test_t* first;
 } ret_list_t;
 
 
 /******************************************************************************
 * P U B L I C    F U N C T I O N    P R O T O T Y P E S
 ******************************************************************************/
+void      retParamInit    (ret_param_t* param, ret_mode_t mode,
+                           char* test_tag);
 void      retStart        (ret_param_t* param);
-ret_retval_t retExecuteList  (ret_param_t* param, ret_list_t* list);
+ret_retval_t retExecuteList  (ret_param_t* param, const ret_list_t* list);
 void      retAssert       (int assert_condition, ret_param_t* param,
-                           int line_number, char *file_name);
+                           int line_number, const char *file_name);
 void retInfoLineFmt(const char* str);
 void retInfoLine(const char* str, bool pause);
+void retSetPerfPort(const ret_perf_port_t* port);
+void retSetCachePort(const ret_cache_port_t* port);
 
 void retConvIntToDecAscii(char* dst_buf, int32_t val);
 
+#ifdef RET_TRACE
+void      retTraceEvent   (char event, const char* name, uint32_t arg);
+#endif
+
+#ifdef RET_VIRTUAL_CLOCK
+uint32_t  retClockNow     (void);
+void      retClockSleep   (uint32_t ticks);
+int32_t   retClockTimer   (uint32_t ticks, uint32_t period,
+                           ret_timer_func_t* func, void* arg);
+void      retClockCancel  (int32_t id);
+#endif
+
+#ifdef RET_COVERAGE
+/* -finstrument-functions hooks (see RET_COVERAGE) */
+void      __cyg_profile_func_enter(void* func, void* call_site)
+            __attribute__((no_instrument_function));
+void      __cyg_profile_func_exit (void* func, void* call_site)
+            __attribute__((no_instrument_function));
+#endif
+
+#ifdef RET_HOST
+/* Provided by the host application (see RET_SYS_TICK_FUNC & RET_SEND_BUF) */
+uint32_t  retHostTick     (void);
+void      retHostSend     (const char* str);
+#ifdef RET_TRACE
+uint32_t  retHostTraceTick(void); /**< Microseconds (see RET_TRACE) */
+#endif
+#ifdef RET_RESUME
+void*     retHostResumeRecord(uint32_t size); /**< Persistent (see RET_RESUME) */
+#endif
+#endif
+
 #endif  /* __RET_H_ */
 
 #ifdef __cplusplus
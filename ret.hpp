@@ -0,0 +1,232 @@
+/**************************************************************************//**
+ * @file ret.hpp
+ * @brief Recursive Embedded Test C++17 tree declaration (optional)
+ *
+ * Declares test lists as constexpr tables that the C engine executes
+ * directly.  Tag lengths are computed at compile time and tag characters,
+ * tree depth and the longest tag path are checked against ret.h, so a tree
+ * that would report RET_ERR_TAG or exceed RET_MAX_NEST_SIZE does not compile.
+ * Branch functions are generated from the lists they execute:
+ * @code
+ * static constexpr add_vector_t add_vectors[] = {...};
+ * static constexpr ret_cases_t add_cases = RET_CASES(add_vectors);
+ * static constexpr const char* add_deps[] = {"Group2Test0", nullptr};
+ *
+ * static constexpr auto group_2 = ret::list(
+ *   ret::leaf(Group2Test0, "Group2Test0"),
+ *   ret::leaf(Group2AddTest, "Group2AddTest", add_cases, add_deps));
+ * static constexpr auto trunk = ret::list(
+ *   ret::leaf(Group1Test0, "Group1Test0"),
+ *   ret::branch<group_2>("group_2_tests"));
+ *
+ * ret_retval_t RunTrunk(ret_param_t* param) {
+ *   return ret::run<trunk>(param);
+ * }
+ * @endcode
+ * Lists (and prerequisite tag arrays) must be declared constexpr for the
+ * checks to apply (a failed check is reported as a non-constant expression
+ * at the offending tag).
+ */
+#ifndef __RET_HPP_
+#define __RET_HPP_
+
+#include <stdint.h>
+#include "ret.h"
+
+namespace ret {
+
+/******************************************************************************
+* P U B L I C    D A T A T Y P E S
+******************************************************************************/
+/**
+ * @brief Test declaration with the limits of its subtree
+ */
+struct node_t {
+  ret_test_t  test; /**< Test as executed by the engine */
+  uint32_t    depth; /**< List levels below the test (0 = leaf) */
+  uint32_t    path_len; /**< Longest tag path of the subtree (ie: @tag[n]) */
+};
+
+/**
+ * @brief Test list with the limits of its subtree
+ */
+template <uint32_t N>
+struct list_t {
+  static constexpr uint32_t size = N;
+  ret_test_t  tests[N]; /**< Tests of the list (const table) */
+  uint32_t    depth; /**< List levels including this list */
+  uint32_t    path_len; /**< Longest tag path below the list */
+};
+
+
+/******************************************************************************
+* S T A T I C    F U N C T I O N S
+******************************************************************************/
+namespace detail {
+
+/**************************************************************************//**
+ * @brief Validate a tag & return its length (compile time)
+ * @param char* - tag
+ * @return uint32_t - tag length
+ */
+constexpr uint32_t tagLength(const char* tag) {
+  uint32_t len = 0;
+
+  if((tag == nullptr) || (tag[0] == '\0'))
+    throw "RET: empty tag";
+  for(; tag[len] != '\0'; len++) {
+    if(tag[len] == '@')
+      throw "RET: '@' is the tag path delimiter";
+    if((tag[len] == '[') || (tag[len] == ']'))
+      throw "RET: '[' and ']' delimit the case index";
+    if(len + 1 >= RET_MAX_TAG_STRING_SIZE)
+      throw "RET: tag exceeds RET_MAX_TAG_STRING_SIZE";
+  }
+  return len;
+}
+
+
+/**************************************************************************//**
+ * @brief Validate the tags of a prerequisite array (compile time)
+ * @param char* const* - nullptr terminated tags or nullptr
+ * @return char* const* - the array
+ */
+constexpr const char* const* depsCheck(const char* const* deps) {
+  if(deps != nullptr) {
+    for(uint32_t n = 0; deps[n] != nullptr; n++)
+      (void)tagLength(deps[n]);
+  }
+  return deps;
+}
+
+
+/**************************************************************************//**
+ * @brief Length of the longest case suffix of a case table
+ *
+ * A search reports the case range of a parameterized leaf (ie: [0-17]),
+ * which is longer than the suffix of any single case.
+ *
+ * @param ret_cases_t& - case table
+ * @return uint32_t - suffix length
+ */
+constexpr uint32_t suffixLength(const ret_cases_t& cases) {
+  uint32_t len = 5;
+
+  if(cases.count == 0)
+    return 2;
+  for(uint32_t last = cases.count - 1; last >= 10; last /= 10)
+    len++;
+  return len;
+}
+
+
+/**
+ * @brief Engine list of a declared list
+ */
+template <const auto& L>
+inline constexpr ret_list_t list_of = { L.size, L.tests };
+
+
+/**************************************************************************//**
+ * @brief Branch function generated for a declared list
+ * @param ret_param_t* - pointer to user control structure
+ * @return ret_retval_t
+ */
+template <const auto& L>
+ret_retval_t runList(ret_param_t* param) {
+  return retExecuteList(param, &list_of<L>);
+}
+
+} /* namespace detail */
+
+
+/******************************************************************************
+* P U B L I C    F U N C T I O N S
+******************************************************************************/
+/**************************************************************************//**
+ * @brief Declare a leaf test
+ * @param ret_func_t* - test function
+ * @param char* - tag
+ * @param char* const* - optional prerequisite tags (see ret_test_t)
+ * @return node_t - declaration
+ */
+constexpr node_t leaf(ret_func_t* func, const char* tag,
+                      const char* const* deps = nullptr) {
+  uint32_t len = detail::tagLength(tag);
+
+  return { { func, tag, nullptr, len, detail::depsCheck(deps) }, 0, 1 + len };
+}
+
+
+/**************************************************************************//**
+ * @brief Declare a parameterized leaf test (see RET_CASES)
+ * @param ret_func_t* - test function
+ * @param char* - tag
+ * @param ret_cases_t& - constexpr case table
+ * @param char* const* - optional prerequisite tags (see ret_test_t)
+ * @return node_t - declaration
+ */
+constexpr node_t leaf(ret_func_t* func, const char* tag,
+                      const ret_cases_t& cases,
+                      const char* const* deps = nullptr) {
+  uint32_t len = detail::tagLength(tag);
+
+  return { { func, tag, &cases, len, detail::depsCheck(deps) }, 0,
+           1 + len + detail::suffixLength(cases) };
+}
+
+
+/**************************************************************************//**
+ * @brief Declare a branch that executes a declared list
+ * @param char* - tag
+ * @param char* const* - optional prerequisite tags (see ret_test_t)
+ * @return node_t - declaration
+ */
+template <const auto& L>
+constexpr node_t branch(const char* tag, const char* const* deps = nullptr) {
+  uint32_t len = detail::tagLength(tag);
+
+  return { { &detail::runList<L>, tag, nullptr, len, detail::depsCheck(deps) },
+           L.depth, 1 + len + L.path_len };
+}
+
+
+/**************************************************************************//**
+ * @brief Declare a test list
+ * @param node_t... - tests in execution order
+ * @return list_t - declaration
+ */
+template <typename... T>
+constexpr list_t<sizeof...(T)> list(const T&... nodes) {
+  static_assert(sizeof...(T) > 0, "RET: empty test list");
+  const node_t all[] = { nodes... };
+  uint32_t depth = 0, path_len = 0;
+
+  for(const node_t& node : all) {
+    if(node.depth > depth)
+      depth = node.depth;
+    if(node.path_len > path_len)
+      path_len = node.path_len;
+  }
+  return { { nodes.test... }, 1 + depth, path_len };
+}
+
+
+/**************************************************************************//**
+ * @brief Execute the trunk list (body of RunTrunk) with the tree limits checked
+ * @param ret_param_t* - pointer to user control structure
+ * @return ret_retval_t
+ */
+template <const auto& L>
+ret_retval_t run(ret_param_t* param) {
+  /* ROOT executes the trunk list, which is nest level 1 */
+  static_assert(L.depth < RET_MAX_NEST_SIZE,
+                "RET: test tree exceeds RET_MAX_NEST_SIZE");
+  static_assert(sizeof RET_ROOT_TAG + L.path_len < RET_MAX_TAG_STRING_SIZE,
+                "RET: tag path exceeds RET_MAX_TAG_STRING_SIZE");
+  return detail::runList<L>(param);
+}
+
+} /* namespace ret */
+
+#endif  /* __RET_HPP_ */
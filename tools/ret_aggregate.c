@@ -0,0 +1,589 @@
+/**************************************************************************//**
+ * @file ret_aggregate.c
+ * @brief Merge the RET report streams of many boards (Linux host)
+ *
+ * Reads the report streams of any number of boards at once (serial ttys,
+ * ptys, pipes/FIFOs or files) with epoll and writes every complete line to
+ * stdout prefixed with the board name, so one log holds all boards:
+ *   board,T,   0,PASS,     0,     0,@ROOT@group_1_tests@Group1Test0
+ * (cut -d, -f2- recovers the report of a board for the other tools).  Lines
+ * are parsed as they complete: T line statuses and R lines are counted per
+ * board and DONE ends a run of a board.  Live progress is shown on stderr and
+ * the per-board results and the tests that failed on any board are printed
+ * to stderr at the end.
+ *
+ * Ttys are set to raw mode (-b sets the baud rate).  Regular files are read
+ * directly (epoll does not poll files).  The tool ends when every stream is
+ * closed, when every board sent -n runs or on SIGINT/SIGTERM.
+ *
+ * Build & use on host:
+ * @code
+ * cc -O2 ret_aggregate.c -o ret_aggregate
+ * ./ret_aggregate -b 115200 -n 1 b1=/dev/ttyACM0 b2=/dev/ttyACM1 > farm.txt
+ * ./ret_aggregate nightly=report.txt local=/tmp/ret.fifo
+ * @endcode
+ * A stream without name= is named by its path.
+ */
+#define _GNU_SOURCE
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <signal.h>
+#include <time.h>
+#include <unistd.h>
+#include <termios.h>
+#include <sys/epoll.h>
+#include <sys/stat.h>
+
+
+/******************************************************************************
+* S T A T I C    D E F I N I T I O N S
+******************************************************************************/
+#define AGG_BUF_SIZE      0x10000 /* Line assembly buffer of a stream */
+#define AGG_READ_SIZE     0x4000 /* Bytes per read() (< AGG_BUF_SIZE) */
+#define AGG_MAX_EVENTS    64
+#define AGG_PROGRESS_MS   1000
+#define AGG_FIELDS        5   /* Fields before the tag (type,line,status,time,net) */
+#define AGG_DONE          "DONE"
+#define AGG_DONE_LEN      4
+
+/* Status values as reported by RET (index = count of the status) */
+static const char* const AGG_STATUS[] = {
+  "PASS", "FAIL", "TIMEOUT", "TAG_ID", "PENDING", "CRASH", "FAULT",
+  "BLOCKED"
+};
+#define AGG_STATUS_COUNT  (sizeof AGG_STATUS / sizeof *AGG_STATUS)
+#define AGG_PASS          0
+#define AGG_FAIL          1
+
+
+/******************************************************************************
+* S T A T I C    D A T A T Y P E S
+******************************************************************************/
+/**
+ * @brief Report stream of a board
+ */
+typedef struct {
+  const char* name; /**< Board name (line prefix) */
+  const char* path;
+  int         fd; /**< -1 = closed */
+  char*       buf; /**< Incomplete line */
+  size_t      len; /**< Bytes in buf */
+  uint64_t    lines; /**< Complete lines */
+  uint64_t    split; /**< Lines longer than AGG_BUF_SIZE (split) */
+  uint32_t    runs; /**< Runs completed (DONE lines) */
+  uint32_t    count[AGG_STATUS_COUNT]; /**< T lines per status */
+  uint32_t    r_pass; /**< Leaf counts of the last R line */
+  uint32_t    r_fail;
+  uint32_t    r_skip;
+  bool        is_r; /**< An R line was received */
+} agg_stream_t;
+
+/**
+ * @brief Test that failed on a board
+ */
+typedef struct {
+  char*       tag;
+  uint32_t    stream;
+  uint32_t    run; /**< Run of the board (from 0) */
+  uint32_t    status;
+} agg_fail_t;
+
+
+/******************************************************************************
+* S T A T I C   D A T A
+******************************************************************************/
+static agg_stream_t* streams;
+static uint32_t     stream_count;
+static uint32_t     open_count;
+static agg_fail_t*  fails;
+static uint32_t     fail_count;
+static uint64_t     total_lines;
+static uint32_t     run_limit;
+static volatile sig_atomic_t is_stop;
+
+
+/******************************************************************************
+* S T A T I C    F U N C T I O N    P R O T O T Y P E S
+******************************************************************************/
+static bool       aggOpen         (agg_stream_t* s, speed_t baud);
+static void       aggClose        (agg_stream_t* s);
+static bool       aggRead         (agg_stream_t* s);
+static void       aggLine         (agg_stream_t* s, char* line, size_t len);
+static void       aggParse        (agg_stream_t* s, char* line);
+static bool       aggIsComplete   (void);
+static void       aggProgress     (bool is_final);
+static void       aggSummary      (void);
+static int        aggFailCompare  (const void* a, const void* b);
+static speed_t    aggBaud         (unsigned long rate);
+static void       aggStop         (int sig);
+
+
+/**************************************************************************//**
+ * @brief Open a stream (raw mode for a tty)
+ * @param agg_stream_t* - stream
+ * @param speed_t - tty baud rate (B0 = unchanged)
+ * @return bool - true if opened
+ */
+static bool aggOpen(agg_stream_t* s, speed_t baud) {
+  struct termios tio;
+
+  s->fd = open(s->path, O_RDONLY | O_NONBLOCK | O_NOCTTY | O_CLOEXEC);
+  if(s->fd < 0) {
+    fprintf(stderr, "%s: %s\n", s->path, strerror(errno));
+    return false;
+  }
+  if(isatty(s->fd) && (tcgetattr(s->fd, &tio) == 0)) {
+    cfmakeraw(&tio);
+    tio.c_cflag |= CLOCAL | CREAD;
+    if(baud != B0)
+      cfsetspeed(&tio, baud);
+    if(tcsetattr(s->fd, TCSANOW, &tio) != 0)
+      fprintf(stderr, "%s: raw mode: %s\n", s->path, strerror(errno));
+  }
+  s->buf = malloc(AGG_BUF_SIZE);
+  if(s->buf == NULL)
+    exit(1);
+  open_count++;
+  return true;
+}
+
+
+/**************************************************************************//**
+ * @brief Close a stream (an incomplete last line is still reported)
+ * @param agg_stream_t* - stream
+ * @return none
+ */
+static void aggClose(agg_stream_t* s) {
+  if(s->fd < 0)
+    return;
+  if(s->len != 0)
+    aggLine(s, s->buf, s->len);
+  s->len = 0;
+  close(s->fd);
+  s->fd = -1;
+  open_count--;
+}
+
+
+/**************************************************************************//**
+ * @brief Read all available data of a stream & report its complete lines
+ * @param agg_stream_t* - stream
+ * @return bool - false at end of stream (or a read error)
+ */
+static bool aggRead(agg_stream_t* s) {
+  static char data[AGG_READ_SIZE];
+  ssize_t   size;
+  char*     pos;
+  char*     end;
+  char*     eol;
+  size_t    part;
+
+  for(;;) {
+    size = read(s->fd, data, sizeof data);
+    if(size < 0) {
+      if(errno == EINTR)
+        continue;
+      /* RET ends a run with DONE without a line feed */
+      if((s->len == AGG_DONE_LEN) && (memcmp(s->buf, AGG_DONE, s->len) == 0)) {
+        aggLine(s, s->buf, s->len);
+        s->len = 0;
+      }
+      /* A pty reports EIO when its other side is closed */
+      return (errno == EAGAIN) || (errno == EWOULDBLOCK);
+    }
+    if(size == 0)
+      return false;
+
+    for(pos = data, end = data + size; pos < end; pos = eol + 1) {
+      eol = memchr(pos, '\n', (size_t)(end - pos));
+      if(eol == NULL) {
+        /* Incomplete line - keep it (split it if it fills the buffer) */
+        part = (size_t)(end - pos);
+        if(s->len + part >= AGG_BUF_SIZE) {
+          s->split++;
+          aggLine(s, s->buf, s->len);
+          s->len = 0;
+        }
+        memcpy(s->buf + s->len, pos, part);
+        s->len += part;
+        break;
+      }
+
+      part = (size_t)(eol - pos);
+      if(s->len == 0) {
+        aggLine(s, pos, part);
+      } else if(s->len + part < AGG_BUF_SIZE) {
+        memcpy(s->buf + s->len, pos, part);
+        aggLine(s, s->buf, s->len + part);
+        s->len = 0;
+      } else {
+        s->split++;
+        aggLine(s, s->buf, s->len);
+        s->len = 0;
+        aggLine(s, pos, part);
+      }
+    }
+  }
+}
+
+
+/**************************************************************************//**
+ * @brief Report a complete line of a stream
+ * @param agg_stream_t* - stream
+ * @param char* - line (without line feed, modified)
+ * @param size_t - line length
+ * @return none
+ */
+static void aggLine(agg_stream_t* s, char* line, size_t len) {
+  char save;
+
+  /* Drop the carriage return of RET line ends & empty lines */
+  if((len != 0) && (line[len - 1] == '\r'))
+    len--;
+  if(len == 0)
+    return;
+
+  /* The next run follows DONE on the same line */
+  if((len > AGG_DONE_LEN) && (memcmp(line, AGG_DONE, AGG_DONE_LEN) == 0)) {
+    aggLine(s, line, AGG_DONE_LEN);
+    aggLine(s, line + AGG_DONE_LEN, len - AGG_DONE_LEN);
+    return;
+  }
+
+  s->lines++;
+  total_lines++;
+  fputs(s->name, stdout);
+  putchar(',');
+  fwrite(line, 1, len, stdout);
+  putchar('\n');
+
+  save = line[len];
+  line[len] = '\0';
+  aggParse(s, line);
+  line[len] = save;
+}
+
+
+/**************************************************************************//**
+ * @brief Count the result of a report line of a stream
+ * @param agg_stream_t* - stream
+ * @param char* - line (terminated, modified)
+ * @return none
+ */
+static void aggParse(agg_stream_t* s, char* line) {
+  char*     field[AGG_FIELDS + 1];
+  char*     pos = line;
+  uint32_t  n, status;
+
+  if(strcmp(line, AGG_DONE) == 0) {
+    s->runs++;
+    return;
+  }
+  if(((line[0] != 'T') && (line[0] != 'R')) || (line[1] != ','))
+    return;
+
+  /* type,line,status,time,net,tag[,pass,fail,skip] */
+  for(n = 0; n <= AGG_FIELDS; n++) {
+    field[n] = pos;
+    pos = strchr(pos, ',');
+    if(pos == NULL) {
+      if(n != AGG_FIELDS)
+        return;
+      break;
+    }
+    *pos++ = '\0';
+  }
+  while(*field[2] == ' ')
+    field[2]++;
+  for(status = 0; status < AGG_STATUS_COUNT; status++) {
+    if(strcmp(field[2], AGG_STATUS[status]) == 0)
+      break;
+  }
+  if(status == AGG_STATUS_COUNT)
+    return;
+
+  if(line[0] == 'R') {
+    if(pos != NULL) {
+      s->r_pass = (uint32_t)strtoul(pos, &pos, 10);
+      s->r_fail = (uint32_t)strtoul(pos + (*pos == ','), &pos, 10);
+      s->r_skip = (uint32_t)strtoul(pos + (*pos == ','), &pos, 10);
+      s->is_r = true;
+    }
+    return;
+  }
+
+  s->count[status]++;
+  if(status != AGG_PASS) {
+    fails = realloc(fails, (fail_count + 1) * sizeof *fails);
+    if(fails == NULL)
+      exit(1);
+    fails[fail_count].tag = strdup(field[AGG_FIELDS]);
+    fails[fail_count].stream = (uint32_t)(s - streams);
+    fails[fail_count].run = s->runs;
+    fails[fail_count].status = status;
+    fail_count++;
+  }
+}
+
+
+/**************************************************************************//**
+ * @brief Check if every board completed the requested runs
+ * @param none
+ * @return bool - true if done (never without -n)
+ */
+static bool aggIsComplete(void) {
+  uint32_t n;
+
+  if(run_limit == 0)
+    return false;
+  for(n = 0; n < stream_count; n++) {
+    if((streams[n].fd >= 0) && (streams[n].runs < run_limit))
+      return false;
+  }
+  return true;
+}
+
+
+/**************************************************************************//**
+ * @brief Show the progress of all boards on stderr
+ * @param bool - true for the last update (ends the line)
+ * @return none
+ */
+static void aggProgress(bool is_final) {
+  uint32_t n, done = 0, pass = 0, fail = 0, status;
+
+  for(n = 0; n < stream_count; n++) {
+    done += (streams[n].runs != 0);
+    pass += streams[n].count[AGG_PASS];
+    for(status = AGG_PASS + 1; status < AGG_STATUS_COUNT; status++)
+      fail += streams[n].count[status];
+  }
+  fprintf(stderr, "\rboards %u/%u done, %u open, lines %llu, pass %u, fail %u%s",
+          done, stream_count, open_count, (unsigned long long)total_lines,
+          pass, fail, is_final ? "\n" : "  ");
+}
+
+
+/**************************************************************************//**
+ * @brief Print the results of each board & the failed tests on stderr
+ * @param none
+ * @return none
+ */
+static void aggSummary(void) {
+  agg_stream_t* s;
+  uint32_t  n, status, other, next, board;
+
+  fprintf(stderr, "%-16s %6s %10s %8s %8s %8s  %s\n",
+          "board", "runs", "lines", "pass", "fail", "other", "last R line");
+  for(n = 0; n < stream_count; n++) {
+    s = &streams[n];
+    for(status = AGG_FAIL + 1, other = 0; status < AGG_STATUS_COUNT; status++)
+      other += s->count[status];
+    fprintf(stderr, "%-16s %6u %10llu %8u %8u %8u", s->name, s->runs,
+            (unsigned long long)s->lines, s->count[AGG_PASS],
+            s->count[AGG_FAIL], other);
+    if(s->is_r)
+      fprintf(stderr, "  pass %u fail %u skip %u", s->r_pass, s->r_fail,
+              s->r_skip);
+    if(s->split != 0)
+      fprintf(stderr, "  (%llu long lines split)",
+              (unsigned long long)s->split);
+    fputc('\n', stderr);
+  }
+
+  /* Failed tests grouped by tag with the boards (& runs) they failed on */
+  qsort(fails, fail_count, sizeof *fails, aggFailCompare);
+  for(n = 0; n < fail_count; n = next) {
+    fprintf(stderr, "%s:", fails[n].tag);
+    for(next = n; (next < fail_count) &&
+        (strcmp(fails[next].tag, fails[n].tag) == 0); next = board) {
+      for(board = next; (board < fail_count) &&
+          (fails[board].stream == fails[next].stream) &&
+          (strcmp(fails[board].tag, fails[n].tag) == 0); board++)
+        ;
+      status = fails[next].status;
+      fprintf(stderr, " %s", streams[fails[next].stream].name);
+      if(status != AGG_FAIL)
+        fprintf(stderr, "(%s)", AGG_STATUS[status]);
+      if(board - next > 1)
+        fprintf(stderr, " x%u", board - next);
+    }
+    fputc('\n', stderr);
+  }
+}
+
+
+/**************************************************************************//**
+ * @brief Order failures by tag, board & run for qsort
+ */
+static int aggFailCompare(const void* a, const void* b) {
+  const agg_fail_t* x = (const agg_fail_t*)a;
+  const agg_fail_t* y = (const agg_fail_t*)b;
+  int cmp = strcmp(x->tag, y->tag);
+
+  if(cmp == 0)
+    cmp = (x->stream > y->stream) - (x->stream < y->stream);
+  if(cmp == 0)
+    cmp = (x->run > y->run) - (x->run < y->run);
+  return cmp;
+}
+
+
+/**************************************************************************//**
+ * @brief Convert a baud rate to a termios speed
+ * @param unsigned long - baud rate
+ * @return speed_t - speed or B0 if not supported
+ */
+static speed_t aggBaud(unsigned long rate) {
+  static const struct { unsigned long rate; speed_t speed; } bauds[] = {
+    {9600, B9600}, {19200, B19200}, {38400, B38400}, {57600, B57600},
+    {115200, B115200}, {230400, B230400}, {460800, B460800},
+    {921600, B921600}, {1000000, B1000000}, {2000000, B2000000},
+    {3000000, B3000000}, {4000000, B4000000}
+  };
+  uint32_t n;
+
+  for(n = 0; n < sizeof bauds / sizeof *bauds; n++) {
+    if(bauds[n].rate == rate)
+      return bauds[n].speed;
+  }
+  return B0;
+}
+
+
+/**************************************************************************//**
+ * @brief SIGINT/SIGTERM handler - stop after the current events
+ */
+static void aggStop(int sig) {
+  (void)sig;
+  is_stop = 1;
+}
+
+
+int main(int argc, char** argv) {
+  struct epoll_event event, events[AGG_MAX_EVENTS];
+  struct sigaction action;
+  struct timespec now, last = {0, 0};
+  struct stat st;
+  agg_stream_t* s;
+  speed_t   baud = B0;
+  char*     eq;
+  int       epfd, ready, n, opt;
+  bool      is_progress = isatty(STDERR_FILENO);
+
+  while((opt = getopt(argc, argv, "b:n:p")) != -1) {
+    switch(opt) {
+      case 'b':
+        baud = aggBaud(strtoul(optarg, NULL, 10));
+        if(baud == B0) {
+          fprintf(stderr, "unsupported baud rate %s\n", optarg);
+          return 2;
+        }
+        break;
+
+      case 'n':
+        run_limit = (uint32_t)strtoul(optarg, NULL, 10);
+        break;
+
+      case 'p':
+        is_progress = true;
+        break;
+
+      default:
+        optind = argc;
+        break;
+    }
+  }
+  if(optind >= argc) {
+    fprintf(stderr, "usage: %s [-b baud] [-n runs] [-p] [name=]path ...\n",
+            argv[0]);
+    return 2;
+  }
+
+  epfd = epoll_create1(EPOLL_CLOEXEC);
+  if(epfd < 0) {
+    perror("epoll_create1");
+    return 1;
+  }
+  memset(&action, 0, sizeof action);
+  action.sa_handler = aggStop;
+  sigaction(SIGINT, &action, NULL);
+  sigaction(SIGTERM, &action, NULL);
+  /* Board output is kept in large blocks to keep up with many streams */
+  setvbuf(stdout, NULL, _IOFBF, 1 << 20);
+
+  stream_count = (uint32_t)(argc - optind);
+  streams = calloc(stream_count, sizeof *streams);
+  if(streams == NULL)
+    return 1;
+  for(n = 0; n < (int)stream_count; n++) {
+    s = &streams[n];
+    s->path = argv[optind + n];
+    s->name = s->path;
+    s->fd = -1;
+    eq = strchr(s->path, '=');
+    if(eq != NULL) {
+      *eq = '\0';
+      s->name = s->path;
+      s->path = eq + 1;
+    }
+    if(!aggOpen(s, baud))
+      continue;
+
+    if((fstat(s->fd, &st) == 0) && S_ISREG(st.st_mode)) {
+      /* Files are read directly (a file is always readable) */
+      while(aggRead(s))
+        ;
+      aggClose(s);
+      continue;
+    }
+    event.events = EPOLLIN;
+    event.data.u32 = (uint32_t)n;
+    if(epoll_ctl(epfd, EPOLL_CTL_ADD, s->fd, &event) != 0) {
+      fprintf(stderr, "%s: epoll: %s\n", s->path, strerror(errno));
+      aggClose(s);
+    }
+  }
+
+  while((open_count != 0) && !is_stop && !aggIsComplete()) {
+    ready = epoll_wait(epfd, events, AGG_MAX_EVENTS,
+                       is_progress ? AGG_PROGRESS_MS : -1);
+    if((ready < 0) && (errno != EINTR)) {
+      perror("epoll_wait");
+      break;
+    }
+    for(n = 0; n < ready; n++) {
+      s = &streams[events[n].data.u32];
+      if(s->fd < 0)
+        continue;
+      /* Hang-up is reported after the remaining data has been read */
+      if(!aggRead(s) || ((events[n].events & EPOLLIN) == 0))
+        aggClose(s);
+    }
+
+    if(is_progress) {
+      clock_gettime(CLOCK_MONOTONIC, &now);
+      if((now.tv_sec - last.tv_sec) * 1000 +
+         (now.tv_nsec - last.tv_nsec) / 1000000 >= AGG_PROGRESS_MS) {
+        last = now;
+        fflush(stdout);
+        aggProgress(false);
+      }
+    }
+  }
+
+  for(n = 0; n < (int)stream_count; n++)
+    aggClose(&streams[n]);
+  close(epfd);
+  fflush(stdout);
+  if(is_progress)
+    aggProgress(true);
+  aggSummary();
+  return fail_count ? 1 : 0;
+}
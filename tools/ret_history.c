@@ -0,0 +1,658 @@
+/**************************************************************************//**
+ * @file ret_history.c
+ * @brief Persistent RET run-history store with cross-run queries (host)
+ *
+ * Ingests RET text reports (T and B lines) into an append-only columnar store
+ * of memory-mapped files in a directory and answers cross-run queries without
+ * an external database.  Each result row holds its run, tag, status, time and
+ * net time in separate column files.  A per-tag chain column links every row
+ * to the previous row of the same tag, so the last N results of a tag are
+ * read without scanning the store.  The run table holds the run ID, ingest
+ * timestamp and row range of every run.
+ *
+ * Build & use on host:
+ * @code
+ * cc -O2 ret_history.c -o ret_history
+ * ./ret_history hist ingest < report.txt        # append a run (-t epoch)
+ * ./ret_history hist pct 95 Group1Test0 500     # p95 net time, last 500 runs
+ * ./ret_history hist trend Group1Test0 20       # status & times per run
+ * ./ret_history hist flaky 1 500                # failure rate above 1 %
+ * ./ret_history hist runs                       # run table
+ * @endcode
+ * Tags are given as a full tag path (ie: @ROOT@group_1_tests@Group1Test0) or
+ * as the last tag of a path when that is unique.
+ */
+#define _DEFAULT_SOURCE
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <time.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+
+/******************************************************************************
+* S T A T I C    D E F I N I T I O N S
+******************************************************************************/
+#define HIST_MAGIC        0x52455448u /* "RETH" */
+#define HIST_VERSION      2
+#define HIST_LINE_SIZE    1024
+#define HIST_MIN_MAP      0x10000
+#define HIST_NONE         UINT32_MAX
+
+/* Column files of the store */
+typedef enum {
+  COL_META,       /* hist_meta_t */
+  COL_RUN,        /* rows: uint32_t run index */
+  COL_TAG,        /* rows: uint32_t tag index */
+  COL_STATUS,     /* rows: uint8_t status */
+  COL_TIME,       /* rows: uint32_t elapsed time */
+  COL_NET,        /* rows: uint32_t net time (less report output) */
+  COL_PREV,       /* rows: uint32_t previous row of the same tag */
+  COL_TAG_OFF,    /* tags: uint32_t offset of the tag string */
+  COL_TAG_LAST,   /* tags: uint32_t last row of the tag */
+  COL_TAG_STR,    /* tag strings ('\0' terminated) */
+  COL_RUNS,       /* runs: hist_run_t */
+  COL_COUNT
+} hist_col_id_t;
+
+/* Status values as reported by RET (index = status column value) */
+static const char* const HIST_STATUS[] = {
+  "PASS", "FAIL", "TIMEOUT", "TAG_ID", "PENDING", "CRASH",
+  "FAULT", "BLOCKED"
+};
+#define HIST_STATUS_COUNT (sizeof HIST_STATUS / sizeof *HIST_STATUS)
+#define HIST_BLOCKED      7 /* Not executed (a prerequisite failed) */
+
+
+/******************************************************************************
+* S T A T I C    D A T A T Y P E S
+******************************************************************************/
+/**
+ * @brief Store counters (first column file)
+ */
+typedef struct {
+  uint32_t  magic;
+  uint32_t  version;
+  uint32_t  rows; /**< Result rows */
+  uint32_t  tags; /**< Distinct tag paths */
+  uint32_t  runs; /**< Ingested runs */
+  uint32_t  str_bytes; /**< Bytes used in the tag string column */
+} hist_meta_t;
+
+/**
+ * @brief Run table entry
+ */
+typedef struct {
+  uint32_t  id; /**< Run ID (from 1) */
+  uint32_t  first_row; /**< First result row of the run */
+  uint32_t  rows; /**< Result rows of the run */
+  uint32_t  reserved;
+  int64_t   time; /**< Ingest timestamp (seconds since the epoch) */
+} hist_run_t;
+
+/**
+ * @brief Memory-mapped column file
+ */
+typedef struct {
+  int       fd;
+  uint8_t*  base;
+  size_t    size; /**< Mapped (file) size */
+} hist_col_t;
+
+/**
+ * @brief Open store
+ */
+typedef struct {
+  hist_col_t  col[COL_COUNT];
+  uint32_t*   hash; /**< Tag index hash table (in memory) */
+  uint32_t    hash_size; /**< Power of two */
+} hist_t;
+
+
+/******************************************************************************
+* S T A T I C   D A T A
+******************************************************************************/
+static const char* const hist_file[COL_COUNT] = {
+  "meta", "row_run", "row_tag", "row_status", "row_time", "row_net", "row_prev",
+  "tag_off", "tag_last", "tag_str", "runs"
+};
+
+
+/******************************************************************************
+* S T A T I C    F U N C T I O N    P R O T O T Y P E S
+******************************************************************************/
+static bool       histOpen        (hist_t* h, const char* dir);
+static void       histClose       (hist_t* h);
+static bool       histReserve     (hist_t* h, hist_col_id_t id, size_t size);
+static uint32_t   histHash        (const char* str);
+static bool       histRehash      (hist_t* h, uint32_t size);
+static uint32_t   histFindTag     (hist_t* h, const char* tag);
+static uint32_t   histAddTag      (hist_t* h, const char* tag);
+static uint32_t   histLookup      (hist_t* h, const char* tag);
+static int        histIngest      (hist_t* h, int64_t timestamp);
+static int        histPercentile  (hist_t* h, double pct, const char* tag,
+                                   uint32_t runs);
+static int        histTrend       (hist_t* h, const char* tag, uint32_t runs);
+static int        histFlaky       (hist_t* h, double pct, uint32_t runs);
+static int        histRuns        (hist_t* h);
+
+/* Column accessors */
+#define META(h)       ((hist_meta_t*)(h)->col[COL_META].base)
+#define U32(h, id)    ((uint32_t*)(h)->col[id].base)
+#define STATUS(h)     ((uint8_t*)(h)->col[COL_STATUS].base)
+#define TAG_STR(h, t) ((const char*)(h)->col[COL_TAG_STR].base + \
+                       U32(h, COL_TAG_OFF)[t])
+#define RUNS(h)       ((hist_run_t*)(h)->col[COL_RUNS].base)
+
+
+/**************************************************************************//**
+ * @brief Open (or create) a store and build the tag index
+ * @param hist_t* - store
+ * @param char* - store directory
+ * @return bool - true on success
+ */
+static bool histOpen(hist_t* h, const char* dir) {
+  char        path[4096];
+  struct stat st;
+  uint32_t    id, size;
+
+  memset(h, 0, sizeof *h);
+  for(id = 0; id < COL_COUNT; id++)
+    h->col[id].fd = -1;
+  mkdir(dir, 0777);
+  for(id = 0; id < COL_COUNT; id++) {
+    snprintf(path, sizeof path, "%s/%s.col", dir, hist_file[id]);
+    h->col[id].fd = open(path, O_RDWR | O_CREAT, 0666);
+    if((h->col[id].fd < 0) || (fstat(h->col[id].fd, &st) != 0)) {
+      perror(path);
+      return false;
+    }
+    if(!histReserve(h, (hist_col_id_t)id, (size_t)st.st_size))
+      return false;
+  }
+
+  if(!histReserve(h, COL_META, sizeof(hist_meta_t)))
+    return false;
+  if(META(h)->magic == 0) {
+    META(h)->magic = HIST_MAGIC;
+    META(h)->version = HIST_VERSION;
+  } else if((META(h)->magic != HIST_MAGIC) ||
+            (META(h)->version != HIST_VERSION)) {
+    fprintf(stderr, "%s: not a RET history store\n", dir);
+    return false;
+  }
+
+  for(size = 1024; size < META(h)->tags * 2; size *= 2)
+    ;
+  return histRehash(h, size);
+}
+
+
+/**************************************************************************//**
+ * @brief Unmap & close a store
+ * @param hist_t* - store
+ * @return none
+ */
+static void histClose(hist_t* h) {
+  uint32_t id;
+
+  for(id = 0; id < COL_COUNT; id++) {
+    if(h->col[id].base != NULL)
+      munmap(h->col[id].base, h->col[id].size);
+    if(h->col[id].fd >= 0)
+      close(h->col[id].fd);
+  }
+  free(h->hash);
+}
+
+
+/**************************************************************************//**
+ * @brief Map at least 'size' bytes of a column file (file grows by doubling)
+ * @param hist_t* - store
+ * @param hist_col_id_t - column
+ * @param size_t - required size in bytes
+ * @return bool - true on success
+ */
+static bool histReserve(hist_t* h, hist_col_id_t id, size_t size) {
+  hist_col_t* col = &h->col[id];
+  size_t      new_size;
+  void*       base;
+
+  if((size <= col->size) && (col->base != NULL || size == 0))
+    return true;
+
+  new_size = (col->size < HIST_MIN_MAP) ? HIST_MIN_MAP : col->size;
+  while(new_size < size)
+    new_size *= 2;
+
+  if(new_size > col->size) {
+    if(ftruncate(col->fd, (off_t)new_size) != 0) {
+      perror(hist_file[id]);
+      return false;
+    }
+  }
+  base = mmap(NULL, new_size, PROT_READ | PROT_WRITE, MAP_SHARED, col->fd, 0);
+  if(base == MAP_FAILED) {
+    perror(hist_file[id]);
+    return false;
+  }
+  if(col->base != NULL)
+    munmap(col->base, col->size);
+  col->base = base;
+  col->size = new_size;
+  return true;
+}
+
+
+/**************************************************************************//**
+ * @brief FNV-1a hash of a tag path
+ * @param char* - tag path
+ * @return uint32_t - hash
+ */
+static uint32_t histHash(const char* str) {
+  uint32_t hash = 2166136261u;
+
+  while(*str)
+    hash = (hash ^ (uint8_t)*str++) * 16777619u;
+  return hash;
+}
+
+
+/**************************************************************************//**
+ * @brief Rebuild the in-memory tag index with 'size' slots
+ * @param hist_t* - store
+ * @param uint32_t - number of slots (power of two)
+ * @return bool - true on success
+ */
+static bool histRehash(hist_t* h, uint32_t size) {
+  uint32_t t, slot;
+
+  free(h->hash);
+  h->hash = malloc(size * sizeof *h->hash);
+  if(h->hash == NULL)
+    return false;
+  h->hash_size = size;
+  memset(h->hash, 0xFF, size * sizeof *h->hash);
+
+  for(t = 0; t < META(h)->tags; t++) {
+    for(slot = histHash(TAG_STR(h, t)) & (size - 1); h->hash[slot] != HIST_NONE;
+        slot = (slot + 1) & (size - 1))
+      ;
+    h->hash[slot] = t;
+  }
+  return true;
+}
+
+
+/**************************************************************************//**
+ * @brief Find a tag path in the tag index
+ * @param hist_t* - store
+ * @param char* - full tag path
+ * @return uint32_t - tag index or HIST_NONE
+ */
+static uint32_t histFindTag(hist_t* h, const char* tag) {
+  uint32_t slot;
+
+  for(slot = histHash(tag) & (h->hash_size - 1); h->hash[slot] != HIST_NONE;
+      slot = (slot + 1) & (h->hash_size - 1)) {
+    if(strcmp(TAG_STR(h, h->hash[slot]), tag) == 0)
+      return h->hash[slot];
+  }
+  return HIST_NONE;
+}
+
+
+/**************************************************************************//**
+ * @brief Find or append a tag path
+ * @param hist_t* - store
+ * @param char* - full tag path
+ * @return uint32_t - tag index or HIST_NONE on error
+ */
+static uint32_t histAddTag(hist_t* h, const char* tag) {
+  hist_meta_t* meta;
+  uint32_t t = histFindTag(h, tag);
+  uint32_t slot;
+  size_t   len = strlen(tag) + 1;
+
+  if(t != HIST_NONE)
+    return t;
+
+  meta = META(h);
+  if(!histReserve(h, COL_TAG_STR, meta->str_bytes + len) ||
+     !histReserve(h, COL_TAG_OFF, (meta->tags + 1) * sizeof(uint32_t)) ||
+     !histReserve(h, COL_TAG_LAST, (meta->tags + 1) * sizeof(uint32_t)))
+    return HIST_NONE;
+
+  t = meta->tags;
+  memcpy(h->col[COL_TAG_STR].base + meta->str_bytes, tag, len);
+  U32(h, COL_TAG_OFF)[t] = meta->str_bytes;
+  U32(h, COL_TAG_LAST)[t] = HIST_NONE;
+  meta->str_bytes += (uint32_t)len;
+  meta->tags++;
+
+  if(meta->tags * 2 > h->hash_size) {
+    if(!histRehash(h, h->hash_size * 2))
+      return HIST_NONE;
+  } else {
+    for(slot = histHash(tag) & (h->hash_size - 1); h->hash[slot] != HIST_NONE;
+        slot = (slot + 1) & (h->hash_size - 1))
+      ;
+    h->hash[slot] = t;
+  }
+  return t;
+}
+
+
+/**************************************************************************//**
+ * @brief Resolve a query tag (full path, or unique last tag of a path)
+ * @param hist_t* - store
+ * @param char* - tag
+ * @return uint32_t - tag index or HIST_NONE
+ */
+static uint32_t histLookup(hist_t* h, const char* tag) {
+  uint32_t t, found = HIST_NONE;
+  size_t   len = strlen(tag), path_len;
+  const char* path;
+
+  t = histFindTag(h, tag);
+  if(t != HIST_NONE)
+    return t;
+
+  for(t = 0; t < META(h)->tags; t++) {
+    path = TAG_STR(h, t);
+    path_len = strlen(path);
+    if((path_len > len) && (path[path_len - len - 1] == '@') &&
+       (strcmp(path + path_len - len, tag) == 0)) {
+      if(found != HIST_NONE) {
+        fprintf(stderr, "%s: ambiguous, use the full tag path\n", tag);
+        return HIST_NONE;
+      }
+      found = t;
+    }
+  }
+  if(found == HIST_NONE)
+    fprintf(stderr, "%s: no results\n", tag);
+  return found;
+}
+
+
+/**************************************************************************//**
+ * @brief Append the T & B lines of a report on stdin as a new run
+ * @param hist_t* - store
+ * @param int64_t - run timestamp
+ * @return int - 0 on success
+ */
+static int histIngest(hist_t* h, int64_t timestamp) {
+  char      line[HIST_LINE_SIZE];
+  char*     field[5];
+  char*     pos;
+  hist_run_t* run;
+  uint32_t  n, t, row, status;
+
+  if(!histReserve(h, COL_RUNS, (META(h)->runs + 1) * sizeof(hist_run_t)))
+    return 1;
+  run = &RUNS(h)[META(h)->runs];
+  run->id = META(h)->runs + 1;
+  run->first_row = META(h)->rows;
+  run->rows = 0;
+  run->time = timestamp;
+
+  while(fgets(line, sizeof line, stdin) != NULL) {
+    line[strcspn(line, "\r\n")] = '\0';
+    if(((line[0] != 'T') && (line[0] != 'B')) || (line[1] != ','))
+      continue;
+
+    /* T|B,line,status,time,net,tag[,rollup...] */
+    for(n = 0, pos = line + 2; n < 4; n++) {
+      field[n] = pos;
+      pos = strchr(pos, ',');
+      if(pos == NULL)
+        break;
+      *pos++ = '\0';
+    }
+    if(n < 4)
+      continue;
+    field[4] = pos;
+    field[4][strcspn(field[4], ",")] = '\0';
+
+    while(*field[1] == ' ')
+      field[1]++;
+    for(status = 0; status < HIST_STATUS_COUNT; status++) {
+      if(strcmp(field[1], HIST_STATUS[status]) == 0)
+        break;
+    }
+    if(status == HIST_STATUS_COUNT)
+      continue;
+
+    t = histAddTag(h, field[4]);
+    row = META(h)->rows;
+    if((t == HIST_NONE) ||
+       !histReserve(h, COL_RUN, (row + 1) * sizeof(uint32_t)) ||
+       !histReserve(h, COL_TAG, (row + 1) * sizeof(uint32_t)) ||
+       !histReserve(h, COL_STATUS, row + 1) ||
+       !histReserve(h, COL_TIME, (row + 1) * sizeof(uint32_t)) ||
+       !histReserve(h, COL_NET, (row + 1) * sizeof(uint32_t)) ||
+       !histReserve(h, COL_PREV, (row + 1) * sizeof(uint32_t)))
+      return 1;
+
+    run = &RUNS(h)[META(h)->runs];
+    U32(h, COL_RUN)[row] = META(h)->runs;
+    U32(h, COL_TAG)[row] = t;
+    STATUS(h)[row] = (uint8_t)status;
+    U32(h, COL_TIME)[row] = (uint32_t)strtoul(field[2], NULL, 10);
+    U32(h, COL_NET)[row] = (uint32_t)strtoul(field[3], NULL, 10);
+    U32(h, COL_PREV)[row] = U32(h, COL_TAG_LAST)[t];
+    U32(h, COL_TAG_LAST)[t] = row;
+    run->rows++;
+    META(h)->rows++;
+  }
+
+  /* Publish the run after its rows */
+  META(h)->runs++;
+  printf("run %u: %u results\n", run->id, run->rows);
+  return 0;
+}
+
+
+/**************************************************************************//**
+ * @brief Compare elapsed times for qsort
+ */
+static int histCompare(const void* a, const void* b) {
+  uint32_t x = *(const uint32_t*)a, y = *(const uint32_t*)b;
+
+  return (x > y) - (x < y);
+}
+
+
+/**************************************************************************//**
+ * @brief First run index of a query over the last 'runs' runs (0 = all)
+ */
+static uint32_t histFirstRun(hist_t* h, uint32_t runs) {
+  return ((runs == 0) || (runs >= META(h)->runs)) ? 0 : META(h)->runs - runs;
+}
+
+
+/**************************************************************************//**
+ * @brief Print the nearest-rank percentile of a tag's net time over recent runs
+ * @param hist_t* - store
+ * @param double - percentile (0 - 100)
+ * @param char* - tag
+ * @param uint32_t - number of recent runs (0 = all)
+ * @return int - 0 on success
+ */
+static int histPercentile(hist_t* h, double pct, const char* tag,
+                          uint32_t runs) {
+  uint32_t t = histLookup(h, tag);
+  uint32_t first_run = histFirstRun(h, runs);
+  uint32_t row, n = 0, rank;
+  uint32_t* times;
+
+  if(t == HIST_NONE)
+    return 1;
+  times = malloc((META(h)->runs - first_run + 1) * sizeof *times);
+  if(times == NULL)
+    return 1;
+
+  for(row = U32(h, COL_TAG_LAST)[t];
+      (row != HIST_NONE) && (U32(h, COL_RUN)[row] >= first_run);
+      row = U32(h, COL_PREV)[row]) {
+    if(n == META(h)->runs - first_run + 1)
+      break;
+    times[n++] = U32(h, COL_NET)[row];
+  }
+  if(n == 0) {
+    fprintf(stderr, "%s: no results in range\n", tag);
+    free(times);
+    return 1;
+  }
+
+  qsort(times, n, sizeof *times, histCompare);
+  rank = (uint32_t)(pct / 100.0 * n + 0.999999);
+  rank = (rank == 0) ? 0 : ((rank > n) ? n - 1 : rank - 1);
+  printf("%s p%g %u (%u results, min %u max %u)\n", TAG_STR(h, t), pct,
+         times[rank], n, times[0], times[n - 1]);
+  free(times);
+  return 0;
+}
+
+
+/**************************************************************************//**
+ * @brief Print status, time & net time of a tag per run, newest first
+ * @param hist_t* - store
+ * @param char* - tag
+ * @param uint32_t - number of recent runs (0 = all)
+ * @return int - 0 on success
+ */
+static int histTrend(hist_t* h, const char* tag, uint32_t runs) {
+  uint32_t t = histLookup(h, tag);
+  uint32_t first_run = histFirstRun(h, runs);
+  uint32_t row;
+  hist_run_t* run;
+  char     date[32];
+  time_t   when;
+
+  if(t == HIST_NONE)
+    return 1;
+  printf("%s\n", TAG_STR(h, t));
+  for(row = U32(h, COL_TAG_LAST)[t];
+      (row != HIST_NONE) && (U32(h, COL_RUN)[row] >= first_run);
+      row = U32(h, COL_PREV)[row]) {
+    run = &RUNS(h)[U32(h, COL_RUN)[row]];
+    when = (time_t)run->time;
+    strftime(date, sizeof date, "%Y-%m-%d %H:%M:%S", localtime(&when));
+    printf("%8u %s %-7s %8u %8u\n", run->id, date,
+           HIST_STATUS[STATUS(h)[row]], U32(h, COL_TIME)[row],
+           U32(h, COL_NET)[row]);
+  }
+  return 0;
+}
+
+
+/**************************************************************************//**
+ * @brief Print tags whose failure rate over recent runs exceeds a percentage
+ *
+ * Blocked results (not executed) are not counted.
+ *
+ * @param hist_t* - store
+ * @param double - failure rate threshold in percent
+ * @param uint32_t - number of recent runs (0 = all)
+ * @return int - 0 on success
+ */
+static int histFlaky(hist_t* h, double pct, uint32_t runs) {
+  uint32_t first_run = histFirstRun(h, runs);
+  uint32_t t, row, total, fail;
+
+  for(t = 0; t < META(h)->tags; t++) {
+    for(row = U32(h, COL_TAG_LAST)[t], total = 0, fail = 0;
+        (row != HIST_NONE) && (U32(h, COL_RUN)[row] >= first_run);
+        row = U32(h, COL_PREV)[row]) {
+      if(STATUS(h)[row] == HIST_BLOCKED)
+        continue;
+      total++;
+      fail += (STATUS(h)[row] != 0);
+    }
+    if((total != 0) && (fail * 100.0 > pct * total))
+      printf("%6.2f%% %6u/%-6u %s\n", fail * 100.0 / total, fail, total,
+             TAG_STR(h, t));
+  }
+  return 0;
+}
+
+
+/**************************************************************************//**
+ * @brief Print the run table
+ * @param hist_t* - store
+ * @return int - 0 on success
+ */
+static int histRuns(hist_t* h) {
+  hist_run_t* run;
+  uint32_t r, row, fail;
+  char     date[32];
+  time_t   when;
+
+  for(r = 0; r < META(h)->runs; r++) {
+    run = &RUNS(h)[r];
+    for(row = run->first_row, fail = 0; row < run->first_row + run->rows; row++)
+      fail += (STATUS(h)[row] != 0) && (STATUS(h)[row] != HIST_BLOCKED);
+    when = (time_t)run->time;
+    strftime(date, sizeof date, "%Y-%m-%d %H:%M:%S", localtime(&when));
+    printf("%8u %s %8u results %6u failed\n", run->id, date, run->rows, fail);
+  }
+  return 0;
+}
+
+
+/**************************************************************************//**
+ * @brief Store tool entry point
+ * @param int - argument count
+ * @param char** - arguments (see file header)
+ * @return int - 0 on success
+ */
+int main(int argc, char** argv) {
+  hist_t   h;
+  int      err = 2;
+  int64_t  timestamp = (int64_t)time(NULL);
+  struct timespec start, end;
+
+  if(argc < 3) {
+    fprintf(stderr, "usage: %s <dir> ingest [-t epoch] | pct <p> <tag> [runs]"
+            " | trend <tag> [runs] | flaky <percent> [runs] | runs\n", argv[0]);
+    return 2;
+  }
+  if(!histOpen(&h, argv[1])) {
+    histClose(&h);
+    return 1;
+  }
+
+  clock_gettime(CLOCK_MONOTONIC, &start);
+  if(strcmp(argv[2], "ingest") == 0) {
+    if((argc > 4) && (strcmp(argv[3], "-t") == 0))
+      timestamp = strtoll(argv[4], NULL, 10);
+    err = histIngest(&h, timestamp);
+  } else if((strcmp(argv[2], "pct") == 0) && (argc > 4)) {
+    err = histPercentile(&h, atof(argv[3]), argv[4],
+                         (argc > 5) ? (uint32_t)strtoul(argv[5], NULL, 10) : 0);
+  } else if((strcmp(argv[2], "trend") == 0) && (argc > 3)) {
+    err = histTrend(&h, argv[3],
+                    (argc > 4) ? (uint32_t)strtoul(argv[4], NULL, 10) : 0);
+  } else if((strcmp(argv[2], "flaky") == 0) && (argc > 3)) {
+    err = histFlaky(&h, atof(argv[3]),
+                    (argc > 4) ? (uint32_t)strtoul(argv[4], NULL, 10) : 0);
+  } else if(strcmp(argv[2], "runs") == 0) {
+    err = histRuns(&h);
+  } else {
+    fprintf(stderr, "unknown command %s\n", argv[2]);
+  }
+  clock_gettime(CLOCK_MONOTONIC, &end);
+  fprintf(stderr, "%.3f ms\n", (end.tv_sec - start.tv_sec) * 1e3 +
+          (end.tv_nsec - start.tv_nsec) / 1e6);
+
+  histClose(&h);
+  return err;
+}
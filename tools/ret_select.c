@@ -0,0 +1,628 @@
+/**************************************************************************//**
+ * @file ret_select.c
+ * @brief Change-based RET test selection (host)
+ *
+ * Builds a map from RET tag paths to the source files and functions each
+ * test calls, using the C lines of a host run built with RET_COVERAGE and the
+ * symbol table of the test executable.  The map then selects the tests that
+ * are affected by a list of changed files (ie: git diff --name-only) or whose
+ * files changed since the test last passed.  Selections are printed one per
+ * line as param->test_tag values (full tag paths, case ranges as tag[n-m]);
+ * a subtree whose tests are all selected is printed as its branch.  Changed
+ * source files that are not in the map (ie: headers) select @ROOT.
+ *
+ * Build & use on host:
+ * @code
+ * cc -O2 ret_select.c -o ret_select
+ * ./ret_test_cov > cov.txt                         # RET_COVERAGE host run
+ * nm -l --defined-only ret_test_cov > nm.txt
+ * ./ret_select map nm.txt < cov.txt > ret.map
+ * git diff --name-only HEAD~1 | ./ret_select diff ret.map
+ * ./ret_select stale ret.map ret.state             # changed since passed
+ * ./ret_select pass ret.map ret.state < report.txt # record passed tests
+ * @endcode
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+
+/******************************************************************************
+* S T A T I C    D E F I N I T I O N S
+******************************************************************************/
+#define SEL_LINE_SIZE     4096
+#define SEL_FIELDS        5   /* Report fields before the tag */
+#define SEL_ROOT_TAG      "@ROOT"
+#define SEL_NONE          UINT32_MAX
+
+
+/******************************************************************************
+* S T A T I C    D A T A T Y P E S
+******************************************************************************/
+/**
+ * @brief Function symbol of the test executable
+ */
+typedef struct {
+  uint64_t  addr;
+  char*     name;
+  char*     file; /**< Source file or NULL (no debug information) */
+} sel_symbol_t;
+
+/**
+ * @brief Test node of the map (in report order, children before parents)
+ */
+typedef struct {
+  char*     tag; /**< Full tag path */
+  uint32_t  parent; /**< Parent node or SEL_NONE */
+  uint32_t* files; /**< Source files called by the test itself */
+  uint32_t  file_count;
+  bool      is_any; /**< Depends on all files (coverage incomplete) */
+  bool      is_selected;
+  uint32_t  children;
+  uint32_t  children_covered;
+} sel_node_t;
+
+
+/******************************************************************************
+* S T A T I C   D A T A
+******************************************************************************/
+static sel_node_t*  nodes;
+static uint32_t     node_count;
+static char**       files;
+static uint32_t     file_count;
+
+
+/******************************************************************************
+* S T A T I C    F U N C T I O N    P R O T O T Y P E S
+******************************************************************************/
+static char*      selReportTag    (char* line, char type);
+static uint32_t   selNode         (const char* tag);
+static uint32_t   selFile         (const char* file);
+static void       selAddFile      (uint32_t node, uint32_t file);
+static bool       selReadMap      (const char* path);
+static int        selMap          (const char* nm_path);
+static bool       selPathMatch    (const char* a, const char* b);
+static bool       selIsSource     (const char* file);
+static uint64_t   selHashNode     (uint32_t node, uint64_t* file_hash);
+static void       selPrint        (void);
+static int        selDiff         (void);
+static int        selStale        (const char* state_path);
+static int        selPass         (const char* state_path);
+
+
+/**************************************************************************//**
+ * @brief Find the tag of a report line of a type
+ * @param char* - report line (modified)
+ * @param char - line type (ie: 'T')
+ * @return char* - tag (terminated) or NULL; the rest follows the terminator
+ */
+static char* selReportTag(char* line, char type) {
+  char* tag;
+  int   n;
+
+  line[strcspn(line, "\r\n")] = '\0';
+  if((line[0] != type) || (line[1] != ','))
+    return NULL;
+
+  /* type,line,status,time,net,tag[,...] */
+  for(n = 0, tag = line + 2; n < SEL_FIELDS - 1; n++) {
+    tag = strchr(tag, ',');
+    if(tag == NULL)
+      return NULL;
+    tag++;
+  }
+  if(tag[strcspn(tag, ",")] == ',')
+    tag[strcspn(tag, ",")] = '\0';
+  return tag;
+}
+
+
+/**************************************************************************//**
+ * @brief Find or add a node (parents are linked when the map is complete)
+ * @param char* - full tag path
+ * @return uint32_t - node index
+ */
+static uint32_t selNode(const char* tag) {
+  uint32_t n;
+
+  for(n = node_count; n-- > 0; ) {
+    if(strcmp(nodes[n].tag, tag) == 0)
+      return n;
+  }
+  nodes = realloc(nodes, (node_count + 1) * sizeof *nodes);
+  if(nodes == NULL)
+    exit(1);
+  memset(&nodes[node_count], 0, sizeof *nodes);
+  nodes[node_count].tag = strdup(tag);
+  nodes[node_count].parent = SEL_NONE;
+  return node_count++;
+}
+
+
+/**************************************************************************//**
+ * @brief Find or add a source file
+ * @param char* - file path
+ * @return uint32_t - file index
+ */
+static uint32_t selFile(const char* file) {
+  uint32_t n;
+
+  for(n = 0; n < file_count; n++) {
+    if(strcmp(files[n], file) == 0)
+      return n;
+  }
+  files = realloc(files, (file_count + 1) * sizeof *files);
+  if(files == NULL)
+    exit(1);
+  files[file_count] = strdup(file);
+  return file_count++;
+}
+
+
+/**************************************************************************//**
+ * @brief Add a source file to a node (once)
+ * @param uint32_t - node index
+ * @param uint32_t - file index
+ * @return none
+ */
+static void selAddFile(uint32_t node, uint32_t file) {
+  sel_node_t* n = &nodes[node];
+  uint32_t    i;
+
+  for(i = 0; i < n->file_count; i++) {
+    if(n->files[i] == file)
+      return;
+  }
+  n->files = realloc(n->files, (n->file_count + 1) * sizeof *n->files);
+  if(n->files == NULL)
+    exit(1);
+  n->files[n->file_count++] = file;
+}
+
+
+/**************************************************************************//**
+ * @brief Compare symbols by address for qsort/bsearch
+ */
+static int selSymbolCompare(const void* a, const void* b) {
+  uint64_t x = ((const sel_symbol_t*)a)->addr;
+  uint64_t y = ((const sel_symbol_t*)b)->addr;
+
+  return (x > y) - (x < y);
+}
+
+
+/**************************************************************************//**
+ * @brief Build the map from nm output and a RET_COVERAGE report (stdin)
+ *
+ * Map lines are N<tab>tag for every reported test (report order),
+ * F<tab>tag<tab>file<tab>function for every called function and A<tab>tag for
+ * a test with incomplete coverage.
+ *
+ * @param char* - output of nm -l --defined-only for the test executable
+ * @return int - 0 on success
+ */
+static int selMap(const char* nm_path) {
+  char          line[SEL_LINE_SIZE];
+  char          type, name[512], *file, *tag, *rest, *end;
+  sel_symbol_t* symbols = NULL;
+  sel_symbol_t  key, *symbol;
+  uint32_t      symbol_count = 0;
+  uint64_t      base = 0;
+  long long     offset;
+  FILE*         nm = fopen(nm_path, "r");
+
+  if(nm == NULL) {
+    perror(nm_path);
+    return 1;
+  }
+  while(fgets(line, sizeof line, nm) != NULL) {
+    line[strcspn(line, "\r\n")] = '\0';
+    if((sscanf(line, "%llx %c %511s", (unsigned long long*)&key.addr, &type,
+               name) != 3) || (strchr("TtWw", type) == NULL))
+      continue;
+    file = strchr(line, '\t');
+    if(file != NULL) {
+      file++;
+      if((end = strrchr(file, ':')) != NULL)
+        *end = '\0';
+    }
+    symbols = realloc(symbols, (symbol_count + 1) * sizeof *symbols);
+    if(symbols == NULL)
+      return 1;
+    symbols[symbol_count].addr = key.addr;
+    symbols[symbol_count].name = strdup(name);
+    symbols[symbol_count].file = (file != NULL) ? strdup(file) : NULL;
+    if(strcmp(name, "retStart") == 0)
+      base = key.addr;
+    symbol_count++;
+  }
+  fclose(nm);
+  if(base == 0) {
+    fprintf(stderr, "%s: retStart not found\n", nm_path);
+    return 1;
+  }
+  qsort(symbols, symbol_count, sizeof *symbols, selSymbolCompare);
+
+  while(fgets(line, sizeof line, stdin) != NULL) {
+    if((tag = selReportTag(line, 'T')) != NULL) {
+      printf("N\t%s\n", tag);
+      continue;
+    }
+    if((tag = selReportTag(line, 'C')) == NULL)
+      continue;
+
+    /* C,line,,,,tag,offset,... (reported before the T line of the test) */
+    rest = tag + strlen(tag);
+    if(*++rest == '\0')
+      continue;
+    for(; *rest != '\0'; rest = end) {
+      if(*rest == '*') {
+        printf("A\t%s\n", tag);
+        break;
+      }
+      offset = strtoll(rest, &end, 10);
+      key.addr = base + (uint64_t)offset;
+      symbol = bsearch(&key, symbols, symbol_count, sizeof *symbols,
+                       selSymbolCompare);
+      if((symbol == NULL) || (symbol->file == NULL))
+        printf("A\t%s\n", tag);
+      else
+        printf("F\t%s\t%s\t%s\n", tag, symbol->file, symbol->name);
+      if(*end == ',')
+        end++;
+      else
+        break;
+    }
+  }
+  return 0;
+}
+
+
+/**************************************************************************//**
+ * @brief Read a map & link each node to its parent
+ * @param char* - map file
+ * @return bool - true on success
+ */
+static bool selReadMap(const char* path) {
+  char      line[SEL_LINE_SIZE];
+  char*     field[3];
+  char*     end;
+  uint32_t  n, p;
+  size_t    len;
+  FILE*     map = fopen(path, "r");
+
+  if(map == NULL) {
+    perror(path);
+    return false;
+  }
+  while(fgets(line, sizeof line, map) != NULL) {
+    line[strcspn(line, "\r\n")] = '\0';
+    field[0] = strtok(line + 2, "\t");
+    field[1] = strtok(NULL, "\t");
+    if(field[0] == NULL)
+      continue;
+    n = selNode(field[0]);
+    if(line[0] == 'A')
+      nodes[n].is_any = true;
+    else if((line[0] == 'F') && (field[1] != NULL))
+      selAddFile(n, selFile(field[1]));
+  }
+  fclose(map);
+
+  /* Parent is the tag path without its last tag (children come first) */
+  for(n = 0; n < node_count; n++) {
+    end = strrchr(nodes[n].tag, '@');
+    len = (end != NULL) ? (size_t)(end - nodes[n].tag) : 0;
+    for(p = n + 1; (len != 0) && (p < node_count); p++) {
+      if((strlen(nodes[p].tag) == len) &&
+         (strncmp(nodes[p].tag, nodes[n].tag, len) == 0)) {
+        nodes[n].parent = p;
+        nodes[p].children++;
+        break;
+      }
+    }
+  }
+  return true;
+}
+
+
+/**************************************************************************//**
+ * @brief Compare two paths, allowing one to be relative to the other
+ * @param char* - path
+ * @param char* - path
+ * @return bool - true if one path ends with the other at a '/' boundary
+ */
+static bool selPathMatch(const char* a, const char* b) {
+  size_t la = strlen(a), lb = strlen(b);
+
+  if(la < lb) {
+    const char* t = a;
+    a = b;
+    b = t;
+    la = lb;
+    lb = strlen(b);
+  }
+  return (strcmp(a + la - lb, b) == 0) &&
+         ((la == lb) || (a[la - lb - 1] == '/'));
+}
+
+
+/**************************************************************************//**
+ * @brief Determine if a file is compiled source (C/C++/assembly)
+ * @param char* - file path
+ * @return bool - true if the file may change test behavior
+ */
+static bool selIsSource(const char* file) {
+  static const char* const ext[] = {
+    ".c", ".h", ".cc", ".cpp", ".cxx", ".hh", ".hpp", ".inc", ".s", ".S"
+  };
+  const char* dot = strrchr(file, '.');
+  uint32_t    n;
+
+  for(n = 0; (dot != NULL) && (n < sizeof ext / sizeof *ext); n++) {
+    if(strcmp(dot, ext[n]) == 0)
+      return true;
+  }
+  return false;
+}
+
+
+/**************************************************************************//**
+ * @brief Print the selected nodes as test tags
+ *
+ * A node is covered if it is selected or all its children are covered.  The
+ * covered nodes whose parent is not covered are printed; consecutive cases
+ * of a parameterized leaf are printed as one case range.
+ *
+ * @param none
+ * @return none
+ */
+static void selPrint(void) {
+  bool*       covered = calloc(node_count + 1, sizeof *covered);
+  uint32_t    n, first = 0, last = 0, index;
+  const char* open;
+  const char* range_tag = NULL;
+  size_t      range_len = 0;
+
+  if(covered == NULL)
+    exit(1);
+  for(n = 0; n < node_count; n++) {
+    covered[n] = nodes[n].is_selected ||
+                 ((nodes[n].children != 0) &&
+                  (nodes[n].children_covered == nodes[n].children));
+    if(covered[n] && (nodes[n].parent != SEL_NONE))
+      nodes[nodes[n].parent].children_covered++;
+  }
+
+  for(n = 0; n < node_count; n++) {
+    if(!covered[n] || ((nodes[n].parent != SEL_NONE) &&
+                       covered[nodes[n].parent]))
+      continue;
+
+    /* Merge consecutive cases (ie: tag[2], tag[3] -> tag[2-3]) */
+    open = strrchr(nodes[n].tag, '[');
+    if((open != NULL) && (strchr(open, '@') == NULL)) {
+      index = (uint32_t)strtoul(open + 1, NULL, 10);
+      if((range_tag != NULL) && (index == last + 1) &&
+         ((size_t)(open - nodes[n].tag) == range_len) &&
+         (strncmp(nodes[n].tag, range_tag, range_len) == 0)) {
+        last = index;
+        continue;
+      }
+      if(range_tag != NULL)
+        printf((first == last) ? "%.*s[%u]\n" : "%.*s[%u-%u]\n",
+               (int)range_len, range_tag, first, last);
+      range_tag = nodes[n].tag;
+      range_len = (size_t)(open - nodes[n].tag);
+      first = last = index;
+      continue;
+    }
+    if(range_tag != NULL)
+      printf((first == last) ? "%.*s[%u]\n" : "%.*s[%u-%u]\n",
+             (int)range_len, range_tag, first, last);
+    range_tag = NULL;
+    printf("%s\n", nodes[n].tag);
+  }
+  if(range_tag != NULL)
+    printf((first == last) ? "%.*s[%u]\n" : "%.*s[%u-%u]\n",
+           (int)range_len, range_tag, first, last);
+  free(covered);
+}
+
+
+/**************************************************************************//**
+ * @brief Select the tests affected by the changed files listed on stdin
+ * @param none
+ * @return int - 0 on success
+ */
+static int selDiff(void) {
+  char      line[SEL_LINE_SIZE];
+  uint32_t  n, i, f;
+  bool      is_mapped;
+  bool*     changed = calloc(file_count + 1, sizeof *changed);
+
+  if(changed == NULL)
+    return 1;
+  while(fgets(line, sizeof line, stdin) != NULL) {
+    line[strcspn(line, "\r\n")] = '\0';
+    if(line[0] == '\0')
+      continue;
+    for(f = 0, is_mapped = false; f < file_count; f++) {
+      if(selPathMatch(files[f], line)) {
+        changed[f] = true;
+        is_mapped = true;
+      }
+    }
+    if(!is_mapped && selIsSource(line)) {
+      /* Headers, macros & untested code - no test map */
+      fprintf(stderr, "%s: not in map, selecting all tests\n", line);
+      printf("%s\n", SEL_ROOT_TAG);
+      free(changed);
+      return 0;
+    }
+  }
+
+  for(n = 0; n < node_count; n++) {
+    nodes[n].is_selected = nodes[n].is_any;
+    for(i = 0; i < nodes[n].file_count; i++)
+      nodes[n].is_selected |= changed[nodes[n].files[i]];
+  }
+  selPrint();
+  free(changed);
+  return 0;
+}
+
+
+/**************************************************************************//**
+ * @brief Hash the contents of the files called by a node (FNV-1a)
+ * @param uint32_t - node index
+ * @param uint64_t* - file hash cache (0 = not hashed yet)
+ * @return uint64_t - node input hash
+ */
+static uint64_t selHashNode(uint32_t node, uint64_t* file_hash) {
+  uint64_t  hash = 14695981039346656037ull;
+  uint32_t  i, f;
+  int       c;
+  FILE*     in;
+
+  for(i = 0; i < nodes[node].file_count; i++) {
+    f = nodes[node].files[i];
+    if(file_hash[f] == 0) {
+      file_hash[f] = 14695981039346656037ull;
+      if((in = fopen(files[f], "rb")) != NULL) {
+        while((c = getc(in)) != EOF)
+          file_hash[f] = (file_hash[f] ^ (uint8_t)c) * 1099511628211ull;
+        fclose(in);
+      } else {
+        file_hash[f] = 1; /* Missing file - never matches a recorded hash */
+      }
+    }
+    hash = (hash ^ file_hash[f]) * 1099511628211ull;
+  }
+  return nodes[node].is_any ? 0 : hash;
+}
+
+
+/**
+ * @brief Recorded input hash of each node (state file: hash<tab>tag)
+ */
+static uint64_t* selReadState(const char* path) {
+  char      line[SEL_LINE_SIZE];
+  char*     tag;
+  uint32_t  n;
+  uint64_t* state = calloc(node_count + 1, sizeof *state);
+  FILE*     in = fopen(path, "r");
+
+  if((state == NULL) || (in == NULL))
+    return state;
+  while(fgets(line, sizeof line, in) != NULL) {
+    line[strcspn(line, "\r\n")] = '\0';
+    if((tag = strchr(line, '\t')) == NULL)
+      continue;
+    for(n = 0; n < node_count; n++) {
+      if(strcmp(nodes[n].tag, tag + 1) == 0)
+        state[n] = strtoull(line, NULL, 16);
+    }
+  }
+  fclose(in);
+  return state;
+}
+
+
+/**************************************************************************//**
+ * @brief Select the tests whose files changed since they last passed
+ * @param char* - state file (see selPass)
+ * @return int - 0 on success
+ */
+static int selStale(const char* state_path) {
+  uint64_t* state = selReadState(state_path);
+  uint64_t* file_hash = calloc(file_count + 1, sizeof *file_hash);
+  uint32_t  n;
+
+  if((state == NULL) || (file_hash == NULL))
+    return 1;
+  for(n = 0; n < node_count; n++) {
+    nodes[n].is_selected = (state[n] == 0) ||
+                           (state[n] != selHashNode(n, file_hash));
+  }
+  selPrint();
+  free(state);
+  free(file_hash);
+  return 0;
+}
+
+
+/**************************************************************************//**
+ * @brief Record the input hashes of the tests passed in a report (stdin)
+ *
+ * Failed leaves are removed from the state so that they are selected again.
+ * Branches fail with their leaves, so a branch is recorded when it executed.
+ *
+ * @param char* - state file
+ * @return int - 0 on success
+ */
+static int selPass(const char* state_path) {
+  char      line[SEL_LINE_SIZE];
+  char*     tag;
+  char*     status;
+  bool      is_pass;
+  uint64_t* state = selReadState(state_path);
+  uint64_t* file_hash = calloc(file_count + 1, sizeof *file_hash);
+  uint32_t  n;
+  FILE*     out;
+
+  if((state == NULL) || (file_hash == NULL))
+    return 1;
+  while(fgets(line, sizeof line, stdin) != NULL) {
+    if((tag = selReportTag(line, 'T')) == NULL)
+      continue;
+    for(status = strchr(line + 2, ',') + 1; *status == ' '; status++)
+      ;
+    is_pass = (strncmp(status, "PASS", 4) == 0);
+    for(n = 0; n < node_count; n++) {
+      if(strcmp(nodes[n].tag, tag) == 0)
+        state[n] = (is_pass || (nodes[n].children != 0)) ?
+                   selHashNode(n, file_hash) : 0;
+    }
+  }
+
+  if((out = fopen(state_path, "w")) == NULL) {
+    perror(state_path);
+    return 1;
+  }
+  for(n = 0; n < node_count; n++) {
+    if(state[n] != 0)
+      fprintf(out, "%016llx\t%s\n", (unsigned long long)state[n],
+              nodes[n].tag);
+  }
+  fclose(out);
+  free(state);
+  free(file_hash);
+  return 0;
+}
+
+
+/**************************************************************************//**
+ * @brief Selection tool entry point
+ * @param int - argument count
+ * @param char** - arguments (see file header)
+ * @return int - 0 on success
+ */
+int main(int argc, char** argv) {
+  if((argc == 3) && (strcmp(argv[1], "map") == 0))
+    return selMap(argv[2]);
+  if((argc >= 3) && !selReadMap(argv[2]))
+    return 1;
+  if((argc == 3) && (strcmp(argv[1], "diff") == 0))
+    return selDiff();
+  if((argc == 4) && (strcmp(argv[1], "stale") == 0))
+    return selStale(argv[3]);
+  if((argc == 4) && (strcmp(argv[1], "pass") == 0))
+    return selPass(argv[3]);
+
+  fprintf(stderr, "usage: %s map <nm output> < report | diff <map> < files"
+          " | stale <map> <state> | pass <map> <state> < report\n", argv[0]);
+  return 2;
+}
@@ -0,0 +1,151 @@
+/**************************************************************************//**
+ * @file ret_trace.c
+ * @brief Convert RET execution trace lines to Chrome trace-event JSON (host)
+ *
+ * Reads a RET report (built with RET_TRACE defined) from stdin and writes the
+ * X lines as Chrome trace-event JSON to stdout.  Other report lines are
+ * ignored, so a captured terminal log can be converted directly.  Each trace
+ * header starts a new process in the output, so a log of several runs shows
+ * each run separately.  Timestamps are unwrapped (32 bit target counters) and
+ * scaled to microseconds with the frequency of the trace header.
+ *
+ * Build & run on host:
+ * @code
+ * cc -O2 ret_trace.c -o ret_trace
+ * ./ret_trace < report.txt > trace.json   # open in ui.perfetto.dev
+ * @endcode
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+
+/******************************************************************************
+* S T A T I C    D E F I N I T I O N S
+******************************************************************************/
+#define TRACE_LINE_SIZE   1024
+#define TRACE_FIELDS      5   /* Fields before the event name */
+
+
+/******************************************************************************
+* S T A T I C    F U N C T I O N    P R O T O T Y P E S
+******************************************************************************/
+static bool traceSplit    (char* line, char** field, char** name);
+static void tracePutName  (const char* name);
+
+
+/**************************************************************************//**
+ * @brief Split an X line into its numeric fields and the event name
+ * @param char* - report line (modified)
+ * @param char** - TRACE_FIELDS field pointers
+ * @param char** - event name
+ * @return bool - true if the line is a trace line
+ */
+static bool traceSplit(char* line, char** field, char** name) {
+  char* end;
+  int   n;
+
+  line[strcspn(line, "\r\n")] = '\0';
+  if((line[0] != 'X') || (line[1] != ','))
+    return false;
+
+  /* X,line,event,time,nest,arg,name (name may contain commas) */
+  for(n = 0, line += 2; n < TRACE_FIELDS; n++) {
+    end = strchr(line, ',');
+    if(end == NULL)
+      return false;
+    *end = '\0';
+    while(*line == ' ')
+      line++;
+    field[n] = line;
+    line = end + 1;
+  }
+  *name = line;
+  return true;
+}
+
+
+/**************************************************************************//**
+ * @brief Write a JSON string
+ * @param char* - string
+ * @return none
+ */
+static void tracePutName(const char* name) {
+  putchar('"');
+  for(; *name; name++) {
+    if((*name == '"') || (*name == '\\'))
+      printf("\\%c", *name);
+    else if((unsigned char)*name < ' ')
+      printf("\\u%04x", (unsigned char)*name);
+    else
+      putchar(*name);
+  }
+  putchar('"');
+}
+
+
+/**************************************************************************//**
+ * @brief Converter entry point
+ * @param none
+ * @return int - 0 on success
+ */
+int main(void) {
+  char      line[TRACE_LINE_SIZE];
+  char*     field[TRACE_FIELDS];
+  char*     name;
+  uint32_t  raw, last_raw = 0;
+  uint64_t  ticks, wraps = 0;
+  double    hz = 1000.0;
+  unsigned  pid = 0;
+  bool      first = true;
+  const char* cat;
+
+  printf("{\"traceEvents\":[\n");
+  while(fgets(line, sizeof line, stdin) != NULL) {
+    if(!traceSplit(line, field, &name))
+      continue;
+
+    raw = (uint32_t)strtoul(field[2], NULL, 10);
+    if(field[1][0] == 'H') {
+      /* Trace header - time field is the timestamp frequency */
+      hz = (raw != 0) ? (double)raw : 1000.0;
+      wraps = 0;
+      last_raw = 0;
+      pid++;
+      if(strtoul(field[4], NULL, 10) != 0)
+        fprintf(stderr, "run %u: %s events dropped (RET_TRACE_BUF_SIZE)\n",
+                pid, field[4]);
+      printf("%s{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":%u,"
+             "\"args\":{\"name\":\"RET run %u\"}}", first ? "" : ",\n",
+             pid, pid);
+      first = false;
+      continue;
+    }
+
+    /* Unwrap 32 bit timestamps (events are in time order) */
+    if(raw < last_raw)
+      wraps += (uint64_t)1 << 32;
+    last_raw = raw;
+    ticks = wraps + raw;
+
+    if(field[1][0] == 'I')
+      cat = "assert";
+    else if(strcmp(name, "flush") == 0)
+      cat = "io";
+    else
+      cat = "ret";
+
+    printf("%s{\"name\":", first ? "" : ",\n");
+    tracePutName(name);
+    printf(",\"cat\":\"%s\",\"ph\":\"%c\",\"ts\":%.3f,\"pid\":%u,\"tid\":1,"
+           "%s\"args\":{\"nest\":%s,\"arg\":%s}}", cat,
+           (field[1][0] == 'I') ? 'i' : field[1][0],
+           (double)ticks * 1e6 / hz, pid ? pid : 1,
+           (field[1][0] == 'I') ? "\"s\":\"t\"," : "", field[3], field[4]);
+    first = false;
+  }
+  printf("\n]}\n");
+  return 0;
+}